@@ -13,6 +13,7 @@
 
 #include <MultiGenerator/Context/Environment.hpp>
 #include <MultiGenerator/Executor/TaskExecutor.hpp>
+#include <MultiGenerator/Executor/ProcessExecutor.hpp>
 #include <MultiGenerator/Variable/Argument.hpp>
 #include <MultiGenerator/Variable/DataConfig.hpp>
 #include <MultiGenerator/Workflow/Task.hpp>
@@ -20,6 +21,8 @@
 #include <MultiGenerator/Interface/Component.hpp>
 #include <MultiGenerator/Interface/Utility.hpp>
 #include <MultiGenerator/Interface/Template.hpp>
+#include <MultiGenerator/Interface/Reducer.hpp>
+#include <MultiGenerator/Interface/Minimizer.hpp>
 
 namespace MultiGenerator {
     /** Reexport some essential classes and functions */
@@ -0,0 +1,307 @@
+/**
+ * @file MultiGenerator/Context/Memory.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief This file contains the accounting of the heap memory allocated by
+ * every task. Define MULTIGENERATOR_MEMORY_TRACKING to replace the global
+ * operator new and operator delete with counting ones, which also turns the
+ * accounting on when the program starts. Otherwise the scopes record nothing.
+ * The replacements are defined in this header, so define the macro in only
+ * one translation unit of a program. The other translation units compile the
+ * same code and find out whether the accounting is on at runtime.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <algorithm>
+
+#include <MultiGenerator/Context/Trace.hpp>
+
+#ifdef MULTIGENERATOR_MEMORY_TRACKING
+#include <malloc.h>
+#endif
+
+namespace MultiGenerator::Context {
+    /**
+     * @brief The heap memory of one stage of a test case.
+     *
+     */
+    struct MemoryRecord {
+        std::string testcase;
+        /** The stage, e.g. "generate" or "solve". */
+        std::string stage;
+        /** The most bytes held at the same time. */
+        long long peak;
+        /** All bytes allocated, including the freed ones. */
+        long long total;
+    };
+
+    /**
+     * @brief The collection of the memory records of all stages of a run, e.g.
+     * one execution of a template. The peak of every test case is kept as the
+     * records are added.
+     *
+     */
+    class MemoryProfile {
+    public:
+        MemoryProfile() :
+            records(),
+            peaks(),
+            mtx() {}
+
+        MemoryProfile(const MemoryProfile &) = delete;
+
+        MemoryProfile &operator=(const MemoryProfile &) = delete;
+
+        /**
+         * @brief Get the profile of the threads which aren't bound to one by
+         * MemoryProfileBinding.
+         *
+         */
+        static MemoryProfile &getInstance() {
+            static MemoryProfile instance;
+            return instance;
+        }
+
+        /**
+         * @brief Get the profile which the scopes of the current thread add their
+         * records to.
+         *
+         */
+        static MemoryProfile &getCurrent() {
+            return (current != nullptr ? *current : getInstance());
+        }
+
+        void add(MemoryRecord record) {
+            std::lock_guard<std::mutex> lock(mtx);
+            auto &peak = peaks[record.testcase];
+            peak = std::max(peak, record.peak);
+            records.push_back(std::move(record));
+        }
+
+        std::vector<MemoryRecord> getRecords() const {
+            std::lock_guard<std::mutex> lock(mtx);
+            return records;
+        }
+
+        /**
+         * @brief Get the largest peak of all stages of a test case, which can be
+         * used as its memory estimate in later runs.
+         *
+         * @param testcase the ID of the test case
+         * @return the peak in bytes, or 0 if it isn't recorded
+         */
+        long long getPeak(const std::string &testcase) const {
+            std::lock_guard<std::mutex> lock(mtx);
+            auto it = peaks.find(testcase);
+            return (it != peaks.end() ? it->second : 0);
+        }
+
+        void clear() {
+            std::lock_guard<std::mutex> lock(mtx);
+            records.clear();
+            peaks.clear();
+        }
+
+        /**
+         * @brief Check whether the accounting is on, i.e. the counting operator
+         * new of MULTIGENERATOR_MEMORY_TRACKING is in the program.
+         *
+         */
+        static bool isEnabled() {
+            return enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Turn the accounting on. It's called before main() by the
+         * translation unit defining MULTIGENERATOR_MEMORY_TRACKING.
+         *
+         */
+        static void enable() {
+            enabled.store(true, std::memory_order_relaxed);
+        }
+
+        friend class MemoryProfileBinding;
+    private:
+        static inline std::atomic_bool enabled = false;
+        static inline thread_local MemoryProfile *current = nullptr;
+
+        std::vector<MemoryRecord> records;
+        std::unordered_map<std::string, long long> peaks;
+        mutable std::mutex mtx;
+    };
+
+    /**
+     * @brief A helper which makes the scopes of the current thread record into
+     * a profile from its construction to its destruction. Binding nullptr keeps
+     * the profile of the thread.
+     *
+     */
+    class MemoryProfileBinding {
+    public:
+        explicit MemoryProfileBinding(MemoryProfile *profile) :
+            previous(MemoryProfile::current) {
+            if (profile != nullptr)
+                MemoryProfile::current = profile;
+        }
+
+        MemoryProfileBinding(const MemoryProfileBinding &) = delete;
+
+        MemoryProfileBinding &operator=(const MemoryProfileBinding &) = delete;
+
+        ~MemoryProfileBinding() {
+            MemoryProfile::current = previous;
+        }
+    private:
+        MemoryProfile *previous;
+    };
+
+    /**
+     * @brief A helper which counts the heap memory allocated and freed by the
+     * current thread from its construction to its destruction, and adds a
+     * MemoryRecord to the current profile of the thread at the end. Only the
+     * innermost scope of a thread counts, and a free of memory allocated
+     * elsewhere is counted too, so the peak is the most bytes held by the
+     * stage itself. It does nothing if the accounting is off.
+     *
+     */
+    class MemoryScope {
+    public:
+        MemoryScope(std::string testcase, std::string stage) :
+            isRecorded(MemoryProfile::isEnabled()),
+            profile(&MemoryProfile::getCurrent()),
+            testcase(std::move(testcase)),
+            stage(std::move(stage)),
+            current(0),
+            peak(0),
+            total(0),
+            previous(nullptr),
+            start() {
+            if (!isRecorded)
+                return;
+
+            previous = active;
+            start = Trace::Clock::now();
+            active = this;
+        }
+
+        MemoryScope(const MemoryScope &) = delete;
+
+        MemoryScope &operator=(const MemoryScope &) = delete;
+
+        ~MemoryScope() {
+            if (!isRecorded)
+                return;
+            /** Stop counting first, since recording allocates too. */
+            active = previous;
+
+            if (Trace::isEnabled()) {
+                Trace::getInstance().record("memory", "memory", start, Trace::Clock::now(), {
+                    { "testcase", testcase },
+                    { "stage", stage },
+                    { "peak bytes", std::to_string(peak) },
+                    { "total bytes", std::to_string(total) }
+                });
+            }
+
+            profile->add({ std::move(testcase), std::move(stage), peak, total });
+        }
+
+        /**
+         * @brief Count an allocation of the current thread. It's called by the
+         * replaced operator new.
+         *
+         * @param size the usable size of the allocated block
+         */
+        static void allocate(std::size_t size) noexcept {
+            if (active == nullptr)
+                return;
+
+            active->current += static_cast<long long>(size);
+            active->total += static_cast<long long>(size);
+            active->peak = std::max(active->peak, active->current);
+        }
+
+        /**
+         * @brief Count a free of the current thread. It's called by the replaced
+         * operator delete.
+         *
+         * @param size the usable size of the freed block
+         */
+        static void deallocate(std::size_t size) noexcept {
+            if (active != nullptr)
+                active->current -= static_cast<long long>(size);
+        }
+    private:
+        static inline thread_local MemoryScope *active = nullptr;
+
+        bool isRecorded;
+        MemoryProfile *profile;
+        std::string testcase;
+        std::string stage;
+        long long current;
+        long long peak;
+        long long total;
+        MemoryScope *previous;
+        Trace::TimePoint start;
+    };
+} // namespace MultiGenerator::Context
+
+#ifdef MULTIGENERATOR_MEMORY_TRACKING
+/** The usable size is counted, so a block is counted the same when it's freed. */
+void *operator new(std::size_t size) {
+    void *ptr;
+
+    while ((ptr = std::malloc(size == 0 ? 1 : size)) == nullptr) {
+        auto handler = std::get_new_handler();
+
+        if (handler == nullptr)
+            throw std::bad_alloc();
+
+        handler();
+    }
+
+    ::MultiGenerator::Context::MemoryScope::allocate(::malloc_usable_size(ptr));
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept {
+    if (ptr == nullptr)
+        return;
+
+    ::MultiGenerator::Context::MemoryScope::deallocate(::malloc_usable_size(ptr));
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    ::operator delete(ptr);
+}
+
+namespace {
+    /** Turn the accounting on before main(). */
+    const struct MemoryTrackingInstaller {
+        MemoryTrackingInstaller() {
+            ::MultiGenerator::Context::MemoryProfile::enable();
+        }
+    } memoryTrackingInstaller;
+} // namespace
+#endif
+
+/**
+ * Record the rest of the enclosing block as a stage of a test case. It expands
+ * to the same code with or without MULTIGENERATOR_MEMORY_TRACKING, and the ID
+ * of the test case is computed only if the accounting is on.
+ */
+#define MULTIGENERATOR_MEMORY_SCOPE(scope, testcase, stage) \
+    ::MultiGenerator::Context::MemoryScope scope( \
+        ::MultiGenerator::Context::MemoryProfile::isEnabled() ? std::string(testcase) : std::string(), (stage))
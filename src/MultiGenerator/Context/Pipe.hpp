@@ -0,0 +1,441 @@
+/**
+ * @file MultiGenerator/Context/Pipe.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief This file contains an in-memory pipe between two threads and the
+ * streams built on it.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <streambuf>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <deque>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+#include <MultiGenerator/Context/Stream.hpp>
+
+namespace MultiGenerator::Context {
+    /**
+     * @brief A bounded in-memory pipe which transfers chunks of bytes from one
+     * writer thread to one reader thread. The writer waits while the pipe holds
+     * capacity chunks, so the reader must run at the same time.
+     *
+     * If the data is written to a file too, call setSpillFile(). Then a writer
+     * which fills the pipe before the reader starts drops the rest of the data
+     * instead of waiting, and the reader reads the rest from the file after the
+     * writer has closed the pipe.
+     *
+     */
+    class Pipe {
+    public:
+        static constexpr std::size_t DEFAULT_CAPACITY = 16;
+
+        Pipe(std::size_t capacity = DEFAULT_CAPACITY) :
+            capacity(std::max<std::size_t>(capacity, 1)),
+            chunks(),
+            spillFile(),
+            writtenSize(0),
+            isSpilled(false),
+            isReading(false),
+            isWriteClosed(false),
+            isReadClosed(false),
+            mtx(),
+            readCond(),
+            writeCond() {}
+
+        ~Pipe() {}
+
+        /**
+         * @brief Let the writer drop the data instead of waiting when the pipe
+         * is full and the reader hasn't started. Call it before writing.
+         *
+         * @param fileName the file which receives the same data as the pipe
+         */
+        void setSpillFile(const std::string &fileName) {
+            std::lock_guard<std::mutex> lock(mtx);
+            spillFile = fileName;
+        }
+
+        /**
+         * @brief Append a chunk. Keep waiting while the pipe is full. It's
+         * discarded if the reader has gone or the pipe has spilled.
+         *
+         * @param chunk the chunk to append
+         */
+        void write(std::string chunk) {
+            if (chunk.empty())
+                return;
+
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+
+                writeCond.wait(lock, [this]() {
+                    return chunks.size() < capacity || isReadClosed || isSpilled
+                        || (!isReading && !spillFile.empty());
+                });
+
+                if (isReadClosed || isSpilled)
+                    return;
+                /** Nobody reads yet, so leave the rest in the file. */
+                if (chunks.size() >= capacity) {
+                    isSpilled = true;
+                    return;
+                }
+
+                writtenSize += chunk.size();
+                chunks.push_back(std::move(chunk));
+            }
+
+            readCond.notify_one();
+        }
+
+        /**
+         * @brief Take the next chunk. Keep waiting until there is one or the
+         * writer has closed the pipe.
+         *
+         * @param chunk the string to store the chunk
+         * @return false if the pipe is closed and empty
+         */
+        bool read(std::string &chunk) {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                isReading = true;
+
+                readCond.wait(lock, [this]() {
+                    return !chunks.empty() || isWriteClosed;
+                });
+
+                if (chunks.empty())
+                    return false;
+
+                chunk = std::move(chunks.front());
+                chunks.pop_front();
+            }
+
+            writeCond.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief Check whether the writer has dropped data. Only meaningful
+         * after read() has returned false.
+         *
+         */
+        bool hasSpilled() const {
+            std::lock_guard<std::mutex> lock(mtx);
+            return isSpilled;
+        }
+
+        const std::string &getSpillFile() const {
+            return spillFile;
+        }
+
+        /**
+         * @brief Get the offset in the spill file where the dropped data begins.
+         *
+         */
+        std::size_t getSpillOffset() const {
+            std::lock_guard<std::mutex> lock(mtx);
+            return writtenSize;
+        }
+
+        /**
+         * @brief Tell the reader that there is no more data.
+         *
+         */
+        void closeWrite() {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                isWriteClosed = true;
+            }
+
+            readCond.notify_all();
+        }
+
+        /**
+         * @brief Tell the writer that nobody reads any more. The remaining data
+         * and all data written later are dropped.
+         *
+         */
+        void closeRead() {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                isReadClosed = true;
+                chunks.clear();
+            }
+
+            writeCond.notify_all();
+        }
+    private:
+        std::size_t capacity;
+        std::deque<std::string> chunks;
+        std::string spillFile;
+        /** How many bytes have been put into the pipe. */
+        std::size_t writtenSize;
+        bool isSpilled;
+        bool isReading;
+        bool isWriteClosed;
+        bool isReadClosed;
+        mutable std::mutex mtx;
+        std::condition_variable readCond;
+        std::condition_variable writeCond;
+    };
+
+    /**
+     * @brief A stream buffer writing to a pipe chunk by chunk.
+     *
+     */
+    class PipeWriteBuffer : public std::streambuf {
+    public:
+        static constexpr std::size_t CHUNK_SIZE = 1 << 16;
+
+        PipeWriteBuffer(std::shared_ptr<Pipe> pipe) :
+            std::streambuf(),
+            pipe(std::move(pipe)),
+            buffer() {
+            reserve();
+        }
+
+        ~PipeWriteBuffer() {
+            sync();
+        }
+    protected:
+        int_type overflow(int_type ch) override {
+            flushChunk();
+
+            if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+                *pptr() = traits_type::to_char_type(ch);
+                pbump(1);
+            }
+
+            return traits_type::not_eof(ch);
+        }
+
+        int sync() override {
+            flushChunk();
+            return 0;
+        }
+    private:
+        std::shared_ptr<Pipe> pipe;
+        std::string buffer;
+
+        void reserve() {
+            buffer.resize(CHUNK_SIZE);
+            setp(buffer.data(), buffer.data() + buffer.size());
+        }
+
+        void flushChunk() {
+            auto size = static_cast<std::size_t>(pptr() - pbase());
+
+            if (size == 0)
+                return;
+
+            buffer.resize(size);
+            pipe->write(std::move(buffer));
+            buffer = std::string();
+            reserve();
+        }
+    };
+
+    /**
+     * @brief A stream buffer reading from a pipe chunk by chunk. If the pipe has
+     * spilled, the rest is read from the spill file.
+     *
+     */
+    class PipeReadBuffer : public std::streambuf {
+    public:
+        PipeReadBuffer(std::shared_ptr<Pipe> pipe) :
+            std::streambuf(),
+            pipe(std::move(pipe)),
+            buffer(),
+            file() {}
+
+        ~PipeReadBuffer() {}
+    protected:
+        int_type underflow() override {
+            if (gptr() != egptr())
+                return traits_type::to_int_type(*gptr());
+
+            if (!(file ? readFile() : readPipe()))
+                return traits_type::eof();
+
+            setg(buffer.data(), buffer.data(), buffer.data() + buffer.size());
+            return traits_type::to_int_type(*gptr());
+        }
+    private:
+        std::shared_ptr<Pipe> pipe;
+        std::string buffer;
+        std::unique_ptr<std::ifstream> file;
+
+        bool readPipe() {
+            if (pipe->read(buffer))
+                return true;
+
+            if (!pipe->hasSpilled())
+                return false;
+
+            file = std::make_unique<std::ifstream>(pipe->getSpillFile(), std::ios::binary);
+
+            if (!file->seekg(static_cast<std::streamoff>(pipe->getSpillOffset())))
+                throw FileOpenFailedException(pipe->getSpillFile());
+
+            return readFile();
+        }
+
+        bool readFile() {
+            buffer.resize(PipeWriteBuffer::CHUNK_SIZE);
+            file->read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.resize(static_cast<std::size_t>(file->gcount()));
+            return !buffer.empty();
+        }
+    };
+
+    /**
+     * @brief An output stream writing to a pipe. The pipe is closed for writing
+     * when the stream is destroyed.
+     *
+     */
+    class PipeOutputStream : public OutputStream {
+    public:
+        PipeOutputStream(std::shared_ptr<Pipe> pipe) :
+            OutputStream(),
+            pipe(pipe),
+            buffer(pipe),
+            os(&buffer) {}
+
+        ~PipeOutputStream() {
+            os.flush();
+            pipe->closeWrite();
+        }
+
+        virtual std::ostream &getStream() override {
+            return os;
+        }
+    private:
+        std::shared_ptr<Pipe> pipe;
+        PipeWriteBuffer buffer;
+        std::ostream os;
+    };
+
+    /**
+     * @brief An input stream reading from a pipe. The pipe is closed for reading
+     * when the stream is destroyed.
+     *
+     */
+    class PipeInputStream : public InputStream {
+    public:
+        PipeInputStream(std::shared_ptr<Pipe> pipe) :
+            InputStream(),
+            pipe(pipe),
+            buffer(pipe),
+            is(&buffer) {}
+
+        ~PipeInputStream() {
+            pipe->closeRead();
+        }
+
+        virtual std::istream &getStream() override {
+            return is;
+        }
+    private:
+        std::shared_ptr<Pipe> pipe;
+        PipeReadBuffer buffer;
+        std::istream is;
+    };
+
+    /**
+     * @brief A stream buffer which copies everything written to two other
+     * stream buffers.
+     *
+     */
+    class TeeBuffer : public std::streambuf {
+    public:
+        static constexpr std::size_t BUFFER_SIZE = 1 << 13;
+
+        TeeBuffer(std::streambuf *first, std::streambuf *second) :
+            std::streambuf(),
+            first(first),
+            second(second),
+            buffer(BUFFER_SIZE, '\0') {
+            setp(buffer.data(), buffer.data() + buffer.size());
+        }
+
+        ~TeeBuffer() {}
+    protected:
+        int_type overflow(int_type ch) override {
+            if (!flushBuffer())
+                return traits_type::eof();
+
+            if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+                *pptr() = traits_type::to_char_type(ch);
+                pbump(1);
+            }
+
+            return traits_type::not_eof(ch);
+        }
+
+        int sync() override {
+            if (!flushBuffer())
+                return -1;
+
+            int res = first->pubsync();
+            return (second->pubsync() == 0 ? res : -1);
+        }
+    private:
+        std::streambuf *first;
+        std::streambuf *second;
+        std::string buffer;
+
+        bool flushBuffer() {
+            auto size = pptr() - pbase();
+            bool res = (first->sputn(pbase(), size) == size);
+            res = (second->sputn(pbase(), size) == size) && res;
+            setp(buffer.data(), buffer.data() + buffer.size());
+            return res;
+        }
+    };
+
+    /**
+     * @brief An output stream which writes to two output streams at the same time.
+     *
+     */
+    class TeeOutputStream : public OutputStream {
+    public:
+        TeeOutputStream(std::unique_ptr<OutputStream> first, std::unique_ptr<OutputStream> second) :
+            OutputStream(),
+            first(std::move(first)),
+            second(std::move(second)),
+            buffer(),
+            os() {}
+
+        ~TeeOutputStream() {
+            if (os)
+                os->flush();
+        }
+
+        virtual std::ostream &getStream() override {
+            /** Open the underlying streams lazily like FileOutputStream. */
+            if (!os) {
+                buffer = std::make_unique<TeeBuffer>(first->getStream().rdbuf(),
+                    second->getStream().rdbuf());
+                os = std::make_unique<std::ostream>(buffer.get());
+            }
+
+            return *os;
+        }
+    private:
+        std::unique_ptr<OutputStream> first;
+        std::unique_ptr<OutputStream> second;
+        std::unique_ptr<TeeBuffer> buffer;
+        std::unique_ptr<std::ostream> os;
+    };
+} // namespace MultiGenerator::Context
\ No newline at end of file
@@ -0,0 +1,434 @@
+/**
+ * @file MultiGenerator/Context/Process.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief This file contains the utilities to run an external program in a
+ * child process with resource limits. Only POSIX systems are supported.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <cerrno>
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+namespace MultiGenerator::Context {
+    class ProcessSpawnFailedException : public std::exception {
+    public:
+        ProcessSpawnFailedException(const std::string &path, int error) :
+            msg("ProcessSpawnFailedException: Failed to run " + path + ": " + std::strerror(error)) {}
+
+        const char *what() const noexcept override {
+            return msg.c_str();
+        }
+    private:
+        std::string msg;
+    };
+
+    /**
+     * @brief The program to run and the limits applied to it.
+     *
+     */
+    struct ProcessConfig {
+        /** The path of the executable. */
+        std::string path;
+        /** The arguments passed to the program, not including argv[0]. */
+        std::vector<std::string> arguments;
+        /** The limit of CPU time in seconds, or 0 for no limit. */
+        double cpuTimeLimit = 0;
+        /** The limit of the address space in bytes, or 0 for no limit. */
+        std::size_t addressSpaceLimit = 0;
+    };
+
+    /**
+     * @brief The resource usage and the exit status of a finished process.
+     *
+     */
+    struct ProcessResult {
+        /** The exit code if the process exited normally, -1 otherwise. */
+        int exitCode = -1;
+        /** The signal which killed the process, 0 if it exited normally. */
+        int signal = 0;
+        /** The wall time in seconds. */
+        double wallTime = 0;
+        /** The user and system CPU time in seconds. */
+        double cpuTime = 0;
+        /** The peak resident set size in bytes. */
+        std::size_t peakMemory = 0;
+
+        bool isSuccessful() const {
+            return signal == 0 && exitCode == 0;
+        }
+    };
+
+    /**
+     * @brief A helper which runs an external program and waits for it.
+     *
+     */
+    class Process {
+    public:
+        /** Checked while waiting for the process, which is killed once it returns true. */
+        using CancellationCheck = std::function<bool()>;
+
+        /**
+         * @brief Run the program with its stdin and stdout redirected to files.
+         *
+         * @param config the program and the limits
+         * @param inputFile the file connected to stdin
+         * @param outputFile the file connected to stdout
+         * @param isCancelled kill the process when it returns true, or empty
+         * @return the result of the process
+         */
+        static ProcessResult run(const ProcessConfig &config, const std::string &inputFile,
+            const std::string &outputFile, const CancellationCheck &isCancelled = {}) {
+            int in = ::open(inputFile.c_str(), O_RDONLY | O_CLOEXEC);
+
+            if (in < 0)
+                throw ProcessSpawnFailedException(inputFile, errno);
+
+            int out = ::open(outputFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+            if (out < 0) {
+                int error = errno;
+                ::close(in);
+                throw ProcessSpawnFailedException(outputFile, error);
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            pid_t pid = -1;
+
+            try {
+                pid = spawn(config, in, out);
+            } catch (...) {
+                ::close(in);
+                ::close(out);
+                throw;
+            }
+
+            ::close(in);
+            ::close(out);
+            return wait(pid, start, isCancelled);
+        }
+
+        /**
+         * @brief Run the program with its stdin and stdout connected to streams
+         * through pipes, which is used to run programs in memory.
+         *
+         * @param config the program and the limits
+         * @param input the stream copied to stdin
+         * @param output the stream which receives stdout
+         * @param isCancelled kill the process when it returns true, or empty
+         * @return the result of the process
+         */
+        static ProcessResult run(const ProcessConfig &config, std::istream &input,
+            std::ostream &output, const CancellationCheck &isCancelled = {}) {
+            int in[2], out[2];
+            /** Use a socket for stdin so that writing to a dead child raises no SIGPIPE. */
+            if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, in) != 0)
+                throw ProcessSpawnFailedException(config.path, errno);
+
+            if (::pipe2(out, O_CLOEXEC) != 0) {
+                int error = errno;
+                ::close(in[0]);
+                ::close(in[1]);
+                throw ProcessSpawnFailedException(config.path, error);
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            pid_t pid = -1;
+
+            try {
+                pid = spawn(config, in[0], out[1]);
+            } catch (...) {
+                for (int fd : { in[0], in[1], out[0], out[1] })
+                    ::close(fd);
+
+                throw;
+            }
+
+            ::close(in[0]);
+            ::close(out[1]);
+            transfer(input, output, in[1], out[0], pid, isCancelled);
+            return wait(pid, start, isCancelled);
+        }
+    private:
+        /** How often the cancellation is checked while waiting. */
+        static constexpr int POLL_INTERVAL = 10;
+
+        static pid_t spawn(const ProcessConfig &config, int in, int out) {
+            /** Prepare everything before fork() since the child may only call async-signal-safe functions. */
+            std::vector<char *> argv;
+            argv.push_back(const_cast<char *>(config.path.c_str()));
+
+            for (const auto &argument : config.arguments)
+                argv.push_back(const_cast<char *>(argument.c_str()));
+
+            argv.push_back(nullptr);
+
+            rlimit cpu{}, memory{};
+
+            if (config.cpuTimeLimit > 0) {
+                cpu.rlim_cur = static_cast<rlim_t>(std::ceil(config.cpuTimeLimit));
+                /** SIGXCPU comes at the soft limit and SIGKILL at the hard one. */
+                cpu.rlim_max = cpu.rlim_cur + 1;
+            }
+
+            if (config.addressSpaceLimit > 0)
+                memory.rlim_cur = memory.rlim_max = static_cast<rlim_t>(config.addressSpaceLimit);
+
+            /** The child reports the errno of a failed exec through this pipe. */
+            int status[2];
+
+            if (::pipe2(status, O_CLOEXEC) != 0)
+                throw ProcessSpawnFailedException(config.path, errno);
+
+            pid_t pid = ::fork();
+
+            if (pid < 0) {
+                int error = errno;
+                ::close(status[0]);
+                ::close(status[1]);
+                throw ProcessSpawnFailedException(config.path, error);
+            }
+
+            if (pid == 0) {
+                int error = 0;
+
+                if (::dup2(in, STDIN_FILENO) < 0 || ::dup2(out, STDOUT_FILENO) < 0)
+                    error = errno;
+                else if (config.cpuTimeLimit > 0 && ::setrlimit(RLIMIT_CPU, &cpu) != 0)
+                    error = errno;
+                else if (config.addressSpaceLimit > 0 && ::setrlimit(RLIMIT_AS, &memory) != 0)
+                    error = errno;
+                else
+                    ::execv(argv[0], argv.data());
+
+                if (error == 0)
+                    error = errno;
+
+                [[maybe_unused]] auto res = ::write(status[1], &error, sizeof(error));
+                ::_exit(127);
+            }
+
+            ::close(status[1]);
+            int error = 0;
+            ssize_t size;
+
+            do {
+                size = ::read(status[0], &error, sizeof(error));
+            } while (size < 0 && errno == EINTR);
+
+            ::close(status[0]);
+            /** The pipe is closed without data if exec succeeded. */
+            if (size == static_cast<ssize_t>(sizeof(error))) {
+                int res;
+                ::waitpid(pid, &res, 0);
+                throw ProcessSpawnFailedException(config.path, error);
+            }
+
+            return pid;
+        }
+
+        static ProcessResult wait(pid_t pid, std::chrono::steady_clock::time_point start,
+            const CancellationCheck &isCancelled) {
+            int status = 0;
+            rusage usage{};
+
+            if (isCancelled)
+                waitUntilExited(pid, isCancelled);
+
+            while (::wait4(pid, &status, 0, &usage) != pid) {
+                if (errno != EINTR)
+                    throw ProcessSpawnFailedException("wait4", errno);
+            }
+
+            /** Take the time at once after the process is reaped. */
+            auto end = std::chrono::steady_clock::now();
+            ProcessResult res;
+            res.wallTime = std::chrono::duration<double>(
+                end - start).count();
+            res.cpuTime = toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime);
+            /** ru_maxrss is in kilobytes on Linux. */
+            res.peakMemory = static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+
+            if (WIFEXITED(status))
+                res.exitCode = WEXITSTATUS(status);
+            else if (WIFSIGNALED(status))
+                res.signal = WTERMSIG(status);
+
+            return res;
+        }
+
+        /**
+         * @brief Wait until the process exits without reaping it, and kill it
+         * once isCancelled returns true. A pidfd wakes the wait as soon as the
+         * process exits, so checking the cancellation adds no delay to it.
+         * Without pidfd, fall back to polling with short sleeps.
+         *
+         */
+        static void waitUntilExited(pid_t pid, const CancellationCheck &isCancelled) {
+            int fd = openPidFD(pid);
+            /** Poll quickly at first so that short processes aren't delayed. */
+            auto delay = std::chrono::microseconds(100);
+
+            while (true) {
+                if (fd >= 0) {
+                    pollfd pfd = { fd, POLLIN, 0 };
+                    int count = ::poll(&pfd, 1, POLL_INTERVAL);
+
+                    if (count > 0)
+                        break;
+
+                    if (count < 0 && errno != EINTR) {
+                        ::close(fd);
+                        fd = -1;
+                    }
+                } else {
+                    siginfo_t info{};
+
+                    if (::waitid(P_PID, static_cast<id_t>(pid), &info, WEXITED | WNOHANG | WNOWAIT) != 0) {
+                        if (errno != EINTR)
+                            break;
+                    } else if (info.si_pid == pid) {
+                        break;
+                    }
+
+                    std::this_thread::sleep_for(delay);
+                    delay = std::min<std::chrono::microseconds>(delay * 2, std::chrono::milliseconds(POLL_INTERVAL));
+                }
+                /** The process is reaped by a blocking wait after SIGKILL. */
+                if (isCancelled()) {
+                    ::kill(pid, SIGKILL);
+                    break;
+                }
+            }
+
+            if (fd >= 0)
+                ::close(fd);
+        }
+
+        /**
+         * @brief Open a pidfd of the process, which is readable once it exits.
+         *
+         * @return the file descriptor, or -1 if pidfd isn't supported
+         */
+        static int openPidFD(pid_t pid) {
+#ifdef SYS_pidfd_open
+            /** A pidfd is always close-on-exec. */
+            return static_cast<int>(::syscall(SYS_pidfd_open, pid, 0));
+#else
+            static_cast<void>(pid);
+            return -1;
+#endif
+        }
+
+        /**
+         * @brief Copy input to the child and the output of the child to output
+         * at the same time, so that neither side blocks on a full pipe.
+         *
+         */
+        static void transfer(std::istream &input, std::ostream &output, int in, int out,
+            pid_t pid, const CancellationCheck &isCancelled) {
+            constexpr std::size_t BUFFER_SIZE = 1 << 16;
+
+            std::string pending;
+            std::size_t offset = 0;
+            std::vector<char> buffer(BUFFER_SIZE);
+            bool hasInput = true;
+
+            ::fcntl(in, F_SETFL, ::fcntl(in, F_GETFL) | O_NONBLOCK);
+
+            while (out >= 0) {
+                if (hasInput && offset == pending.size()) {
+                    input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                    pending.assign(buffer.data(), static_cast<std::size_t>(input.gcount()));
+                    offset = 0;
+
+                    if (pending.empty()) {
+                        hasInput = false;
+                        ::close(in);
+                        in = -1;
+                    }
+                }
+
+                pollfd fds[2] = {
+                    { out, POLLIN, 0 },
+                    { in, POLLOUT, 0 }
+                };
+
+                int count = ::poll(fds, (in >= 0 ? 2 : 1), (isCancelled ? POLL_INTERVAL : -1));
+
+                if (count < 0) {
+                    if (errno == EINTR)
+                        continue;
+
+                    break;
+                }
+                /** Stop at once since the children of the process may keep the pipes open. */
+                if (count == 0) {
+                    if (isCancelled()) {
+                        ::kill(pid, SIGKILL);
+                        ::close(out);
+                        out = -1;
+                    }
+
+                    continue;
+                }
+
+                if (in >= 0 && (fds[1].revents & (POLLOUT | POLLERR | POLLHUP))) {
+                    ssize_t size = ::send(in, pending.data() + offset, pending.size() - offset,
+                        MSG_NOSIGNAL);
+
+                    if (size >= 0) {
+                        offset += static_cast<std::size_t>(size);
+                    } else if (errno != EAGAIN && errno != EINTR) {
+                        /** The child doesn't read any more. */
+                        hasInput = false;
+                        ::close(in);
+                        in = -1;
+                    }
+                }
+
+                if (fds[0].revents & (POLLIN | POLLERR | POLLHUP)) {
+                    ssize_t size = ::read(out, buffer.data(), buffer.size());
+
+                    if (size > 0) {
+                        output.write(buffer.data(), size);
+                    } else if (size == 0 || errno != EINTR) {
+                        ::close(out);
+                        out = -1;
+                    }
+                }
+            }
+
+            if (in >= 0)
+                ::close(in);
+        }
+
+        static double toSeconds(const timeval &time) {
+            return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_usec) / 1e6;
+        }
+    };
+} // namespace MultiGenerator::Context
\ No newline at end of file
@@ -12,10 +12,15 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <optional>
+#include <algorithm>
 #include <string>
+#include <atomic>
 #include <exception>
 
+#include <MultiGenerator/Context/Trace.hpp>
+
 namespace MultiGenerator::Context {
     class FileOpenFailedException : std::exception {
     public:
@@ -29,6 +34,9 @@ namespace MultiGenerator::Context {
         std::string msg;
     };
     
+    /** The bytes written by all FileOutputStream objects after they are closed. */
+    inline std::atomic<long long> writtenByteCount(0);
+
     /**
      * @brief An interface which declares a standard behavior to get an input stream.
      * 
@@ -58,13 +66,26 @@ namespace MultiGenerator::Context {
     public:
         FileInputStream(const std::string &fileName) :
             fileName(fileName),
-            ifs() {}
-
-        ~FileInputStream() {}
+            ifs(),
+            openTime() {}
+
+        ~FileInputStream() {
+            if (Trace::isEnabled() && ifs.is_open()) {
+                /** The position is -1 at the end of file until the state is cleared. */
+                ifs.clear();
+                Trace::getInstance().record("read", "io", openTime, Trace::Clock::now(), {
+                    { "file", fileName }, { "bytes", std::to_string(static_cast<long long>(ifs.tellg())) }
+                });
+            }
+        }
 
         virtual std::istream &getStream() override {
-            if (!ifs.is_open())
+            if (!ifs.is_open()) {
+                if (Trace::isEnabled())
+                    openTime = Trace::Clock::now();
+
                 ifs.open(fileName);
+            }
 
             if (ifs.fail())
                 throw FileOpenFailedException(fileName);
@@ -74,6 +95,26 @@ namespace MultiGenerator::Context {
     private:
         std::string fileName;
         std::ifstream ifs;
+        /** When the file is opened, only set if the trace is on. */
+        Trace::TimePoint openTime;
+    };
+
+    /**
+     * @brief An input stream reading from a string kept in memory.
+     * 
+     */
+    class StringInputStream : public InputStream {
+    public:
+        StringInputStream(const std::string &content) :
+            iss(content) {}
+
+        ~StringInputStream() {}
+
+        virtual std::istream &getStream() override {
+            return iss;
+        }
+    private:
+        std::istringstream iss;
     };
 
     /**
@@ -105,13 +146,30 @@ namespace MultiGenerator::Context {
     public:
         FileOutputStream(const std::string &fileName) :
             fileName(fileName),
-            ofs() {}
+            ofs(),
+            openTime() {}
+
+        ~FileOutputStream() {
+            if (!ofs.is_open())
+                return;
 
-        ~FileOutputStream() {}
+            long long bytes = std::max<long long>(0, static_cast<long long>(ofs.tellp()));
+            writtenByteCount.fetch_add(bytes, std::memory_order_relaxed);
+
+            if (Trace::isEnabled()) {
+                Trace::getInstance().record("write", "io", openTime, Trace::Clock::now(), {
+                    { "file", fileName }, { "bytes", std::to_string(bytes) }
+                });
+            }
+        }
 
         virtual std::ostream &getStream() override {
-            if (!ofs.is_open())
+            if (!ofs.is_open()) {
+                if (Trace::isEnabled())
+                    openTime = Trace::Clock::now();
+
                 ofs.open(fileName);
+            }
 
             if (ofs.fail())
                 throw FileOpenFailedException(fileName);
@@ -121,5 +179,34 @@ namespace MultiGenerator::Context {
     private:
         std::string fileName;
         std::ofstream ofs;
+        /** When the file is opened, only set if the trace is on. */
+        Trace::TimePoint openTime;
+    };
+
+    /**
+     * @brief An output stream writing to a string kept in memory.
+     * 
+     */
+    class StringOutputStream : public OutputStream {
+    public:
+        StringOutputStream() :
+            oss() {}
+
+        ~StringOutputStream() {}
+
+        virtual std::ostream &getStream() override {
+            return oss;
+        }
+
+        /**
+         * @brief Get everything written to the stream so far.
+         * 
+         * @return the content
+         */
+        std::string getContent() const {
+            return oss.str();
+        }
+    private:
+        std::ostringstream oss;
     };
 } // namespace MultiGenerator::Context
\ No newline at end of file
@@ -0,0 +1,322 @@
+/**
+ * @file MultiGenerator/Context/Trace.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief This file contains the recorder of the execution timeline, which is
+ * exported as Chrome trace events. Define MULTIGENERATOR_TRACE in any
+ * translation unit of a program to turn the recording on when the program
+ * starts. Every translation unit compiles the same code and finds out whether
+ * the recording is on at runtime, so the macro may differ between them.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+#include <fstream>
+#include <iostream>
+
+namespace MultiGenerator::Context {
+    /**
+     * @brief A span of time on one thread, e.g. the execution of a task.
+     *
+     */
+    struct TraceEvent {
+        std::string name;
+        /** A static string such as "task" or "io". */
+        const char *category;
+        /** The time since the first recorded event in nanoseconds. */
+        std::int64_t start;
+        std::int64_t duration;
+        std::vector<std::pair<const char *, std::string>> arguments;
+    };
+
+    /**
+     * @brief The recorder of the execution timeline. Every thread appends its
+     * events to its own buffer, so recording never waits for other threads.
+     *
+     */
+    class Trace {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+
+        Trace(const Trace &) = delete;
+
+        Trace &operator=(const Trace &) = delete;
+
+        static Trace &getInstance() {
+            static Trace instance;
+            return instance;
+        }
+
+        /**
+         * @brief Record an event on the current thread.
+         *
+         * @param name the name shown in the timeline
+         * @param category a static string grouping the events
+         * @param start when the event started
+         * @param end when the event ended
+         * @param arguments the extra information shown with the event
+         */
+        void record(std::string name, const char *category, TimePoint start, TimePoint end,
+            std::vector<std::pair<const char *, std::string>> arguments = {}) {
+            auto &buffer = getBuffer();
+            std::lock_guard<std::mutex> lock(buffer.mtx);
+            buffer.events.push_back({ std::move(name), category, toOffset(start),
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(),
+                std::move(arguments) });
+        }
+
+        /**
+         * @brief Set the name of the current thread shown in the timeline.
+         *
+         * @param name the name
+         */
+        void setThreadName(const std::string &name) {
+            auto &buffer = getBuffer();
+            std::lock_guard<std::mutex> lock(buffer.mtx);
+            buffer.name = name;
+        }
+
+        /**
+         * @brief Drop all recorded events.
+         *
+         */
+        void clear() {
+            std::lock_guard<std::mutex> lock(mtx);
+
+            for (auto &buffer : buffers) {
+                std::lock_guard<std::mutex> bufferLock(buffer->mtx);
+                buffer->events.clear();
+            }
+        }
+
+        std::size_t getEventCount() const {
+            std::lock_guard<std::mutex> lock(mtx);
+            std::size_t res = 0;
+
+            for (const auto &buffer : buffers) {
+                std::lock_guard<std::mutex> bufferLock(buffer->mtx);
+                res += buffer->events.size();
+            }
+
+            return res;
+        }
+
+        /**
+         * @brief Write all events in the Chrome trace event format, which can be
+         * opened by chrome://tracing or Perfetto. Call it after the execution.
+         *
+         * @param os the stream to write
+         */
+        void exportChromeTrace(std::ostream &os) const {
+            std::lock_guard<std::mutex> lock(mtx);
+            os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+            bool isFirst = true;
+
+            auto separate = [&os, &isFirst]() {
+                if (!isFirst)
+                    os << ",";
+
+                os << "\n";
+                isFirst = false;
+            };
+
+            for (const auto &buffer : buffers) {
+                std::lock_guard<std::mutex> bufferLock(buffer->mtx);
+                separate();
+                os << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->id
+                    << ",\"args\":{\"name\":\"" << escape(buffer->name) << "\"}}";
+
+                for (const auto &event : buffer->events) {
+                    separate();
+                    os << "{\"ph\":\"X\",\"name\":\"" << escape(event.name) << "\",\"cat\":\""
+                        << escape(event.category) << "\",\"pid\":1,\"tid\":" << buffer->id
+                        << ",\"ts\":" << toMicroseconds(event.start)
+                        << ",\"dur\":" << toMicroseconds(event.duration) << ",\"args\":{";
+
+                    for (std::size_t i = 0; i < event.arguments.size(); ++i) {
+                        os << (i == 0 ? "" : ",") << "\"" << escape(event.arguments[i].first)
+                            << "\":\"" << escape(event.arguments[i].second) << "\"";
+                    }
+
+                    os << "}}";
+                }
+            }
+
+            os << "\n]}\n";
+        }
+
+        /**
+         * @brief Same as exportChromeTrace(std::ostream &), but write to a file.
+         *
+         * @param fileName the name of the file
+         * @return false if the file can't be written
+         */
+        bool exportChromeTrace(const std::string &fileName) const {
+            std::ofstream ofs(fileName);
+
+            if (!ofs)
+                return false;
+
+            exportChromeTrace(ofs);
+            return static_cast<bool>(ofs);
+        }
+
+        /**
+         * @brief Check whether the recording is on, i.e. a translation unit of
+         * the program defines MULTIGENERATOR_TRACE.
+         *
+         */
+        static bool isEnabled() {
+            return enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Turn the recording on. It's called before main() by every
+         * translation unit defining MULTIGENERATOR_TRACE.
+         *
+         */
+        static void enable() {
+            enabled.store(true, std::memory_order_relaxed);
+        }
+    private:
+        static inline std::atomic_bool enabled = false;
+
+        /**
+         * @brief The events of one thread. It's kept after the thread quits.
+         *
+         */
+        struct Buffer {
+            int id;
+            std::string name;
+            std::vector<TraceEvent> events;
+            std::mutex mtx;
+        };
+
+        TimePoint origin;
+        std::vector<std::shared_ptr<Buffer>> buffers;
+        mutable std::mutex mtx;
+
+        Trace() :
+            origin(Clock::now()),
+            buffers(),
+            mtx() {}
+
+        Buffer &getBuffer() {
+            thread_local std::shared_ptr<Buffer> buffer;
+
+            if (!buffer) {
+                buffer = std::make_shared<Buffer>();
+                std::lock_guard<std::mutex> lock(mtx);
+                buffer->id = static_cast<int>(buffers.size()) + 1;
+                buffer->name = "thread " + std::to_string(buffer->id);
+                buffers.push_back(buffer);
+            }
+
+            return *buffer;
+        }
+
+        std::int64_t toOffset(TimePoint time) const {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(time - origin).count();
+        }
+
+        static std::string toMicroseconds(std::int64_t nanoseconds) {
+            char str[32];
+            std::snprintf(str, sizeof(str), "%.3f", static_cast<double>(nanoseconds) / 1000);
+            return str;
+        }
+
+        static std::string escape(const std::string &str) {
+            std::string res;
+
+            for (char ch : str) {
+                if (ch == '"' || ch == '\\') {
+                    res += '\\';
+                    res += ch;
+                } else if (static_cast<unsigned char>(ch) < 0x20) {
+                    char code[8];
+                    std::snprintf(code, sizeof(code), "\\u%04x", ch);
+                    res += code;
+                } else {
+                    res += ch;
+                }
+            }
+
+            return res;
+        }
+    };
+
+    /**
+     * @brief A helper which records an event from its construction to its
+     * destruction on the current thread. It does nothing if the recording is off.
+     *
+     */
+    class TraceScope {
+    public:
+        TraceScope(const char *name, const char *category) :
+            recorded(Trace::isEnabled()),
+            name(name),
+            category(category),
+            start(recorded ? Trace::Clock::now() : Trace::TimePoint()),
+            arguments() {}
+
+        TraceScope(const TraceScope &) = delete;
+
+        TraceScope &operator=(const TraceScope &) = delete;
+
+        ~TraceScope() {
+            if (recorded) {
+                Trace::getInstance().record(name, category, start, Trace::Clock::now(),
+                    std::move(arguments));
+            }
+        }
+
+        bool isRecorded() const {
+            return recorded;
+        }
+
+        void addArgument(const char *key, std::string value) {
+            arguments.emplace_back(key, std::move(value));
+        }
+    private:
+        bool recorded;
+        const char *name;
+        const char *category;
+        Trace::TimePoint start;
+        std::vector<std::pair<const char *, std::string>> arguments;
+    };
+} // namespace MultiGenerator::Context
+
+#ifdef MULTIGENERATOR_TRACE
+namespace {
+    /** Turn the recording on before main(). */
+    const struct TraceInstaller {
+        TraceInstaller() {
+            ::MultiGenerator::Context::Trace::enable();
+        }
+    } traceInstaller;
+} // namespace
+#endif
+
+/**
+ * Record the rest of the enclosing block as an event named name, which is a
+ * static string. They expand to the same code with or without
+ * MULTIGENERATOR_TRACE, and the value of an argument is computed only if the
+ * recording is on.
+ */
+#define MULTIGENERATOR_TRACE_SCOPE(scope, name, category) \
+    ::MultiGenerator::Context::TraceScope scope((name), (category))
+#define MULTIGENERATOR_TRACE_ARGUMENT(scope, key, value) \
+    ((scope).isRecorded() ? (scope).addArgument((key), (value)) : (void)0)
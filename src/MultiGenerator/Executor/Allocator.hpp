@@ -0,0 +1,129 @@
+/**
+ * @file MultiGenerator/Executor/Allocator.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief An allocator which reuses the memory of the released runners.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <cstddef>
+#include <algorithm>
+#include <new>
+#include <mutex>
+
+namespace MultiGenerator::Executor {
+    /**
+     * @brief A thread-safe pool of memory blocks of the same size. Released
+     * blocks are kept and handed out again instead of being freed.
+     *
+     * The released blocks form an intrusive free list, each one holding the
+     * address of the next, so releasing a block never allocates or throws.
+     *
+     */
+    class BlockPool {
+    public:
+        static constexpr std::size_t DEFAULT_BLOCK_SIZE = 256;
+
+        BlockPool(std::size_t blockSize = DEFAULT_BLOCK_SIZE) :
+            blockSize(std::max(blockSize, sizeof(FreeBlock))),
+            head(nullptr),
+            mtx() {}
+
+        BlockPool(const BlockPool &) = delete;
+
+        BlockPool &operator=(const BlockPool &) = delete;
+
+        ~BlockPool() {
+            while (head != nullptr) {
+                FreeBlock *next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+        }
+
+        std::size_t getBlockSize() const {
+            return blockSize;
+        }
+
+        void *allocate() {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+
+                if (head != nullptr) {
+                    FreeBlock *res = head;
+                    head = res->next;
+                    return res;
+                }
+            }
+
+            return ::operator new(blockSize);
+        }
+
+        void deallocate(void *block) noexcept {
+            std::lock_guard<std::mutex> lock(mtx);
+            head = ::new (block) FreeBlock{ head };
+        }
+    private:
+        struct FreeBlock {
+            FreeBlock *next;
+        };
+
+        std::size_t blockSize;
+        FreeBlock *head;
+        std::mutex mtx;
+    };
+
+    /**
+     * @brief An allocator taking memory from a BlockPool, which is used with
+     * std::allocate_shared so that an object and its reference count share one
+     * reused block. Requests which don't fit in a block use operator new.
+     *
+     * @tparam Value the type of the allocated objects
+     */
+    template <typename Value>
+    class PoolAllocator {
+    public:
+        using value_type = Value;
+
+        PoolAllocator(BlockPool &pool) noexcept :
+            pool(&pool) {}
+
+        template <typename Other>
+        PoolAllocator(const PoolAllocator<Other> &rhs) noexcept :
+            pool(rhs.getPool()) {}
+
+        Value *allocate(std::size_t count) {
+            if (count * sizeof(Value) <= pool->getBlockSize() && alignof(Value) <= alignof(std::max_align_t))
+                return static_cast<Value *>(pool->allocate());
+
+            return static_cast<Value *>(::operator new(count * sizeof(Value)));
+        }
+
+        void deallocate(Value *ptr, std::size_t count) noexcept {
+            if (count * sizeof(Value) <= pool->getBlockSize() && alignof(Value) <= alignof(std::max_align_t))
+                pool->deallocate(ptr);
+            else
+                ::operator delete(ptr);
+        }
+
+        BlockPool *getPool() const noexcept {
+            return pool;
+        }
+
+        template <typename Other>
+        bool operator==(const PoolAllocator<Other> &rhs) const noexcept {
+            return pool == rhs.getPool();
+        }
+
+        template <typename Other>
+        bool operator!=(const PoolAllocator<Other> &rhs) const noexcept {
+            return pool != rhs.getPool();
+        }
+    private:
+        BlockPool *pool;
+    };
+} // namespace MultiGenerator::Executor
@@ -12,83 +12,174 @@
 
 #include <mutex>
 #include <condition_variable>
-#include <queue>
 #include <atomic>
 #include <exception>
 #include <memory>
 #include <optional>
 #include <chrono>
+#include <thread>
+#include <algorithm>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#endif
 
 namespace MultiGenerator::Executor {
     /**
-     * @brief A simple concurrent queue based on std::queue.
-     * 
+     * @brief A growable circular buffer used as a queue. Unlike std::queue, it
+     * doesn't allocate any more after reaching the max size it has held.
+     * Not thread-safe.
+     *
      * @tparam Element the type of the data stored by the queue
      */
     template <typename Element>
-    class ConcurrentQueue {
+    class RingQueue {
     public:
-        ConcurrentQueue() :
-            que(),
-            mtx() {}
+        RingQueue() :
+            buffer(),
+            head(0),
+            count(0) {}
 
-        ~ConcurrentQueue() {}
+        ~RingQueue() {}
 
-        void push(const Element &element) {
-            std::lock_guard<std::mutex> lock(mtx);
-            que.push(element);
-        }
+        template <typename Value>
+        void push(Value &&element) {
+            if (count == buffer.size())
+                grow();
 
-        void push(Element &&element) {
-            std::lock_guard<std::mutex> lock(mtx);
-            que.push(std::move(element));
+            buffer[(head + count) % buffer.size()].emplace(std::forward<Value>(element));
+            ++count;
         }
 
-        template <typename ...Args>
-        void emplace(Args &&...args) {
-            std::lock_guard<std::mutex> lock(mtx);
-            que.emplace(std::forward<Args>(args)...);
-        }
-
-        /**
-         * @brief Return the element at the front of the queue and remove it
-         * from the queue.
-         *
-         * @return the first element when the queue is not empty; std::nullopt otherwise
-         */
         std::optional<Element> pop() {
-            std::lock_guard<std::mutex> lock(mtx);
-
-            if (!que.empty()) {
-                Element res = std::move(que.front());
-                que.pop();
-                return res;
-            } else {
+            if (count == 0)
                 return std::nullopt;
-            }
+
+            auto &slot = buffer[head];
+            std::optional<Element> res(std::move(slot));
+            slot.reset();
+            head = (head + 1) % buffer.size();
+            --count;
+            return res;
         }
 
         bool empty() const {
-            std::lock_guard lock(mtx);
-            return que.empty();
+            return count == 0;
+        }
+
+        std::size_t size() const {
+            return count;
         }
     private:
-        std::queue<Element> que;
-        mutable std::mutex mtx;
+        std::vector<std::optional<Element>> buffer;
+        std::size_t head;
+        std::size_t count;
+
+        void grow() {
+            std::vector<std::optional<Element>> res(std::max<std::size_t>(buffer.size() * 2, 16));
+
+            for (std::size_t i = 0; i < count; ++i)
+                res[i] = std::move(buffer[(head + i) % buffer.size()]);
+
+            buffer = std::move(res);
+            head = 0;
+        }
     };
 
+    /**
+     * @brief Tell the CPU that the thread is spinning, so that it saves power
+     * and leaves more resource to the other hyper-thread.
+     *
+     */
+    inline void pause() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield");
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    /**
+     * @brief The data shared by all senders and receivers of a channel. The
+     * queue and the count of sleeping receivers are guarded by one mutex.
+     *
+     */
     template <typename Element>
     struct ChannelData {
-        ConcurrentQueue<Element> que;
+        /** The max count of spinning before a receiver sleeps. */
+        static constexpr int MAX_SPIN_COUNT = 256;
+
+        RingQueue<Element> que;
+        /** The size of que, which can be read without the lock while spinning. */
+        std::atomic<std::size_t> size;
         std::mutex mtx;
         std::condition_variable cond;
         std::atomic_int senderCount;
+        /** How many receivers are sleeping on cond. */
+        int waiterCount;
+        /** The average count of spinning before getting data recently. */
+        std::atomic_int spinEstimate;
 
         ChannelData() :
             que(),
+            size(0),
             mtx(),
             cond(),
-            senderCount(0) {}
+            senderCount(0),
+            waiterCount(0),
+            spinEstimate(MAX_SPIN_COUNT / 4) {}
+
+        bool isEmpty() const {
+            return size.load(std::memory_order_acquire) == 0;
+        }
+
+        /**
+         * @brief Push an element and return whether a receiver is sleeping.
+         * The caller must hold the lock.
+         *
+         */
+        template <typename Value>
+        bool push(Value &&element) {
+            que.push(std::forward<Value>(element));
+            size.store(que.size(), std::memory_order_release);
+            return waiterCount != 0;
+        }
+
+        /**
+         * @brief Pop an element if there is one. The caller must hold the lock.
+         *
+         */
+        std::optional<Element> pop() {
+            auto res = que.pop();
+            size.store(que.size(), std::memory_order_release);
+            return res;
+        }
+
+        /**
+         * @brief Spin for a while until there is data or the channel is closed.
+         * The limit adapts to how long the data took to arrive recently.
+         *
+         */
+        void spin() {
+            int estimate = spinEstimate.load(std::memory_order_relaxed);
+            int limit = std::min(estimate * 2 + 16, MAX_SPIN_COUNT);
+
+            for (int i = 0; i < limit; ++i) {
+                if (!isEmpty() || senderCount.load(std::memory_order_acquire) == 0) {
+                    spinEstimate.store(estimate + (i - estimate) / 8, std::memory_order_relaxed);
+                    return;
+                }
+
+                pause();
+            }
+            /** Spinning didn't pay off, so spin less next time. */
+            spinEstimate.store(estimate - estimate / 8, std::memory_order_relaxed);
+        }
     };
 
     /**
@@ -140,7 +231,7 @@ namespace MultiGenerator::Executor {
          * @return true if the channel still has data inside.
          */
         bool isOpen() const {
-            return hasSender() || (channel && !channel->que.empty());
+            return hasSender() || (channel && !channel->isEmpty());
         }
 
         /**
@@ -151,24 +242,10 @@ namespace MultiGenerator::Executor {
          * @return the data from the channel or std::nullopt if it's closed
          */
         std::optional<Element> receive() {
-            if (!channel)
-                return std::nullopt;
-
-            auto res = channel->que.pop();
-            /** Get the reamin element first. */
-            if (res.has_value())
-                return res;
-            else if (channel->senderCount == 0)
-                return std::nullopt;
-            /** res is std::nullopt here. */
-            std::unique_lock<std::mutex> lock(channel->mtx);
-
-            channel->cond.wait(lock, [&, this]() {
-                res = channel->que.pop();
-                return (res.has_value() || channel->senderCount == 0);
+            return receiveWith([this](std::unique_lock<std::mutex> &lock) {
+                channel->cond.wait(lock);
+                return true;
             });
-
-            return res;
         }
 
         /**
@@ -181,24 +258,7 @@ namespace MultiGenerator::Executor {
          */
         template <typename Rep, typename Period>
         std::optional<Element> receiveFor(std::chrono::duration<Rep, Period> dura) {
-            if (!channel)
-                return std::nullopt;
-
-            auto res = channel->que.pop();
-            /** Get the reamin element first. */
-            if (res.has_value())
-                return res;
-            else if (channel->senderCount == 0)
-                return std::nullopt;
-            /** res is std::nullopt here. */
-            std::unique_lock<std::mutex> lock(channel->mtx);
-
-            channel->cond.wait_for(lock, dura, [&, this]() {
-                res = channel->que.pop();
-                return (res.has_value() || channel->senderCount == 0);
-            });
-
-            return res;
+            return receiveUntil(std::chrono::steady_clock::now() + dura);
         }
 
         /**
@@ -211,24 +271,9 @@ namespace MultiGenerator::Executor {
          */
         template <typename Clock, typename Duration>
         std::optional<Element> receiveUntil(std::chrono::time_point<Clock, Duration> point) {
-            if (!channel)
-                return std::nullopt;
-
-            auto res = channel->que.pop();
-            /** Get the reamin element first. */
-            if (res.has_value())
-                return res;
-            else if (channel->senderCount == 0)
-                return std::nullopt;
-            /** res is std::nullopt here. */
-            std::unique_lock<std::mutex> lock(channel->mtx);
-
-            channel->cond.wait_until(lock, point, [&, this]() {
-                res = channel->que.pop();
-                return (res.has_value() || channel->senderCount == 0);
+            return receiveWith([this, point](std::unique_lock<std::mutex> &lock) {
+                return channel->cond.wait_until(lock, point) == std::cv_status::no_timeout;
             });
-
-            return res;
         }
 
         std::weak_ptr<ChannelData<Element>> getHandle() const {
@@ -253,6 +298,37 @@ namespace MultiGenerator::Executor {
         }
     private:
         std::shared_ptr<ChannelData<Element>> channel;
+
+        /**
+         * @brief Spin briefly and then sleep until there is data or the channel is
+         * closed. The receiver counts itself as a waiter while sleeping, so that
+         * the senders don't notify when nobody sleeps.
+         *
+         * @param wait the function which sleeps and returns false if timeout
+         */
+        template <typename Wait>
+        std::optional<Element> receiveWith(Wait wait) {
+            if (!channel)
+                return std::nullopt;
+
+            auto &data = *channel;
+
+            if (data.isEmpty() && data.senderCount != 0)
+                data.spin();
+
+            std::unique_lock<std::mutex> lock(data.mtx);
+
+            while (data.que.empty() && data.senderCount != 0) {
+                ++data.waiterCount;
+                bool res = wait(lock);
+                --data.waiterCount;
+
+                if (!res)
+                    break;
+            }
+
+            return data.pop();
+        }
     };
 
     /**
@@ -324,14 +400,11 @@ namespace MultiGenerator::Executor {
          * @return false if the channel is closed
          */
         bool send(const Element &element) {
-            auto ptr = channel.lock();
-
-            if (!ptr)
-                return false;
+            return sendValue(element);
+        }
 
-            ptr->que.push(element);
-            ptr->cond.notify_one();
-            return true;
+        bool send(Element &&element) {
+            return sendValue(std::move(element));
         }
 
         void connect(std::weak_ptr<ChannelData<Element>> handle) {
@@ -369,14 +442,42 @@ namespace MultiGenerator::Executor {
             auto ptr = channel.lock();
 
             if (ptr) {
-                --ptr->senderCount;
-                ptr->cond.notify_one();
+                bool hasWaiter;
+                /** Change the count with the lock held, otherwise a receiver may miss it. */
+                {
+                    std::lock_guard<std::mutex> lock(ptr->mtx);
+                    --ptr->senderCount;
+                    hasWaiter = (ptr->waiterCount != 0);
+                }
+
+                if (hasWaiter)
+                    ptr->cond.notify_all();
             }
 
             channel.reset();
         }
     private:
         std::weak_ptr<ChannelData<Element>> channel;
+
+        template <typename Value>
+        bool sendValue(Value &&element) {
+            auto ptr = channel.lock();
+
+            if (!ptr)
+                return false;
+
+            bool hasWaiter;
+
+            {
+                std::lock_guard<std::mutex> lock(ptr->mtx);
+                hasWaiter = ptr->push(std::forward<Value>(element));
+            }
+            /** Skip the system call if no receiver sleeps. */
+            if (hasWaiter)
+                ptr->cond.notify_one();
+
+            return true;
+        }
     };
 
     class InvalidChannelCountException : public std::exception {
@@ -0,0 +1,114 @@
+/**
+ * @file MultiGenerator/Executor/Failure.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief The failures of task groups and how the executors react to them.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <mutex>
+#include <exception>
+
+#include <MultiGenerator/Workflow/Cancellation.hpp>
+#include <MultiGenerator/Workflow/TaskGroup.hpp>
+
+namespace MultiGenerator::Executor {
+    /**
+     * @brief A task group which failed.
+     *
+     */
+    struct Failure {
+        /** The ID of the test case. */
+        std::string testcase;
+        std::string reason;
+        /** The ID of the failed task in its group, or -1 if unknown. */
+        int task = -1;
+    };
+
+    /**
+     * @brief What to do with the other groups after a group fails.
+     *
+     */
+    enum class FailurePolicy {
+        /** Execute all other groups and report every failure. */
+        ContinueAndReport,
+        /** Cancel the whole run and skip the groups which haven't finished. */
+        FailFast
+    };
+
+    /**
+     * @brief A thread-safe collection of the failures of one run. It cancels
+     * the failed group, and the whole run if the policy is FailFast. Only the
+     * first failure of a group is kept.
+     *
+     */
+    class FailureCollector {
+    public:
+        FailureCollector(FailurePolicy policy) :
+            policy(policy),
+            runToken(Workflow::CancellationToken::create()),
+            failures(),
+            failedGroups(),
+            mtx() {}
+
+        ~FailureCollector() {}
+
+        /**
+         * @brief Record the exception thrown by a task.
+         *
+         * @param group the group of the task
+         * @param task the ID of the task in the group
+         * @param error the exception
+         */
+        void fail(const Workflow::TaskGroup &group, int task, std::exception_ptr error) {
+            group.cancel();
+
+            if (policy == FailurePolicy::FailFast)
+                runToken.cancel();
+
+            std::lock_guard<std::mutex> lock(mtx);
+            /** A task cancelled after a timeout may throw again. */
+            if (!failedGroups.insert(&group).second)
+                return;
+
+            failures.push_back({ group.getArgument()->getID(), describe(error), task });
+        }
+
+        /**
+         * @brief Get the token which is cancelled when the run fails fast.
+         *
+         */
+        const Workflow::CancellationToken &getRunToken() const {
+            return runToken;
+        }
+
+        std::vector<Failure> getFailures() const {
+            std::lock_guard<std::mutex> lock(mtx);
+            return failures;
+        }
+
+        static std::string describe(std::exception_ptr error) {
+            try {
+                std::rethrow_exception(error);
+            } catch (const std::exception &e) {
+                return e.what();
+            } catch (...) {
+                return "unknown exception";
+            }
+        }
+    private:
+        FailurePolicy policy;
+        Workflow::CancellationToken runToken;
+        std::vector<Failure> failures;
+        /** The groups are kept by the executor during the run, so their addresses identify them. */
+        std::unordered_set<const Workflow::TaskGroup *> failedGroups;
+        mutable std::mutex mtx;
+    };
+} // namespace MultiGenerator::Executor
@@ -0,0 +1,403 @@
+/**
+ * @file MultiGenerator/Executor/ProcessExecutor.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief A executor which dispatches task groups to worker processes.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <chrono>
+#include <cstdlib>
+#include <climits>
+#include <exception>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include <MultiGenerator/Workflow/Runner.hpp>
+#include <MultiGenerator/Workflow/TaskGroup.hpp>
+#include <MultiGenerator/Workflow/Registry.hpp>
+#include <MultiGenerator/Executor/Channel.hpp>
+#include <MultiGenerator/Executor/ThreadPool.hpp>
+#include <MultiGenerator/Executor/TaskExecutor.hpp>
+#include <MultiGenerator/Executor/Socket.hpp>
+#include <MultiGenerator/Executor/Protocol.hpp>
+#include <MultiGenerator/Executor/Failure.hpp>
+
+extern char **environ;
+
+namespace MultiGenerator::Executor {
+    /** The environment variable which passes the socket to a worker process. */
+    inline constexpr char WORKER_ENVIRONMENT[] = "MULTIGENERATOR_WORKER_FD";
+
+    /** A task group which failed in a worker process. */
+    using RemoteFailure = Failure;
+
+    class WorkerEnvironmentInvalidException : public std::exception {
+    public:
+        const char *what() const noexcept override {
+            return "WorkerEnvironmentInvalidException: The process wasn't started as a worker.";
+        }
+    };
+
+    /**
+     * @brief A runner which owns one worker process and sends it the groups one
+     * by one. A worker which crashes or sends a broken reply is restarted and
+     * the group is retried. A worker which doesn't reply in time is killed and
+     * the group fails.
+     *
+     */
+    class WorkerSlotRunner : public Workflow::Runner {
+    public:
+        /** How much longer a new worker has for its first reply, since it runs main() again first. */
+        static constexpr std::chrono::seconds WORKER_START_TIME{ 10 };
+
+        WorkerSlotRunner(const std::vector<Workflow::TaskGroup> &groups, Receiver<int> groupReceiver,
+            Sender<RemoteFailure> failureSender, int maxRetryCount, std::chrono::milliseconds taskTimeLimit) :
+            Workflow::Runner(),
+            groups(groups),
+            groupReceiver(std::move(groupReceiver)),
+            failureSender(std::move(failureSender)),
+            maxRetryCount(maxRetryCount),
+            taskTimeLimit(taskTimeLimit),
+            connection(),
+            pid(-1),
+            isTimedOut(false) {}
+
+        ~WorkerSlotRunner() {}
+    private:
+        const std::vector<Workflow::TaskGroup> &groups;
+        Receiver<int> groupReceiver;
+        Sender<RemoteFailure> failureSender;
+        int maxRetryCount;
+        std::chrono::milliseconds taskTimeLimit;
+        Connection connection;
+        pid_t pid;
+        /** Whether the last request ran out of time. */
+        bool isTimedOut;
+
+        void run() override {
+            while (true) {
+                auto index = groupReceiver.receive();
+
+                if (!index.has_value())
+                    break;
+
+                const auto &group = groups[index.value()];
+                auto message = GroupDescriptor::create(index.value(), group).encode();
+                /** A worker runs the tasks of a group one by one. */
+                auto timeLimit = taskTimeLimit * group.getTaskCount();
+                int attempt = 0;
+
+                while (true) {
+                    auto reply = request(message, timeLimit);
+                    std::string reason;
+
+                    if (reply.has_value()) {
+                        try {
+                            MessageReader reader(reply.value());
+
+                            if (reader.readString() != "ok")
+                                fail(group, reader.readString());
+
+                            break;
+                        } catch (const MessageInvalidException &) {
+                            /** The worker died while sending it or is broken, so start another. */
+                            killWorker();
+                            reap();
+                            reason = "invalid reply from the worker";
+                        }
+                    } else if (isTimedOut) {
+                        /** It would most likely hang again, so don't retry. */
+                        killWorker();
+                        reap();
+                        fail(group, "worker timed out after " + std::to_string(timeLimit.count()) + " ms");
+                        break;
+                    } else {
+                        reason = reap();
+                    }
+
+                    if (++attempt > maxRetryCount) {
+                        fail(group, reason);
+                        break;
+                    }
+                }
+            }
+
+            connection.close();
+            reap();
+            failureSender.reset();
+        }
+
+        /**
+         * @brief Send a group and wait for the reply, starting a worker if needed.
+         *
+         * @param message the group
+         * @param timeLimit how long to wait for the reply, or 0 for no limit
+         * @return the reply, or std::nullopt if the worker has gone or timed out
+         */
+        std::optional<std::string> request(const std::string &message, std::chrono::milliseconds timeLimit) {
+            isTimedOut = false;
+            bool isStarted = !connection.isOpen();
+
+            if (isStarted && !spawn())
+                return std::nullopt;
+
+            if (!connection.send(message))
+                return std::nullopt;
+
+            if (timeLimit.count() == 0)
+                return connection.receive();
+
+            auto deadline = std::chrono::steady_clock::now() + timeLimit;
+
+            if (isStarted)
+                deadline += WORKER_START_TIME;
+
+            auto res = connection.receive(deadline);
+            isTimedOut = (!res.has_value() && std::chrono::steady_clock::now() >= deadline);
+            return res;
+        }
+
+        void killWorker() {
+            if (pid > 0)
+                ::kill(pid, SIGKILL);
+        }
+
+        void fail(const Workflow::TaskGroup &group, const std::string &reason) {
+            failureSender.send({ group.getArgument()->getID(), reason, -1 });
+        }
+
+        /**
+         * @brief Start the same program in worker mode connected by a socket pair.
+         *
+         */
+        bool spawn() {
+            auto pair = Connection::createPair();
+
+            if (!pair.has_value())
+                return false;
+
+            auto &[local, remote] = pair.value();
+            /** Prepare everything before fork() since the child may only call async-signal-safe functions. */
+            auto arguments = readCommandLine();
+            std::vector<char *> argv;
+
+            for (auto &argument : arguments)
+                argv.push_back(argument.data());
+
+            argv.push_back(nullptr);
+
+            std::string variable = std::string(WORKER_ENVIRONMENT) + "=" + std::to_string(remote.getHandle());
+            std::vector<char *> envp;
+
+            for (char **env = environ; *env != nullptr; ++env) {
+                if (std::string(*env).rfind(std::string(WORKER_ENVIRONMENT) + "=", 0) != 0)
+                    envp.push_back(*env);
+            }
+
+            envp.push_back(variable.data());
+            envp.push_back(nullptr);
+
+            int fd = remote.getHandle();
+            pid = ::fork();
+
+            if (pid < 0)
+                return false;
+
+            if (pid == 0) {
+                /** Keep the socket open across exec. */
+                ::fcntl(fd, F_SETFD, 0);
+                ::execve("/proc/self/exe", argv.data(), envp.data());
+                ::_exit(127);
+            }
+
+            remote.close();
+            connection = std::move(local);
+            return true;
+        }
+
+        /**
+         * @brief Wait for the worker process to quit.
+         *
+         * @return the description of how it quitted
+         */
+        std::string reap() {
+            connection.close();
+
+            if (pid < 0)
+                return "failed to start the worker";
+
+            int status = 0;
+
+            while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+
+            pid = -1;
+
+            if (WIFSIGNALED(status))
+                return "worker killed by signal " + std::to_string(WTERMSIG(status));
+            else
+                return "worker exited with code " + std::to_string(WEXITSTATUS(status));
+        }
+
+        static std::vector<std::string> readCommandLine() {
+            std::ifstream ifs("/proc/self/cmdline", std::ios::binary);
+            std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+            std::vector<std::string> res;
+            std::size_t begin = 0;
+
+            while (begin < content.size()) {
+                auto end = content.find('\0', begin);
+
+                if (end == std::string::npos)
+                    end = content.size();
+
+                res.push_back(content.substr(begin, end - begin));
+                begin = end + 1;
+            }
+
+            return res;
+        }
+    };
+
+    /**
+     * @brief A executor which runs every task group in a separate worker process,
+     * which is the same program started in worker mode. It's used to survive
+     * crashes in user code and to get more address space than one process has.
+     *
+     */
+    class ProcessExecutor {
+    public:
+        ProcessExecutor() :
+            maxRetryCount(2),
+            taskTimeLimit(0) {}
+
+        ~ProcessExecutor() {}
+
+        /**
+         * @brief Set how many times a group is retried after its worker crashed.
+         *
+         * @param maxRetryCount the count
+         */
+        void setMaxRetryCount(int maxRetryCount) {
+            this->maxRetryCount = maxRetryCount;
+        }
+
+        /**
+         * @brief Give a worker taskTimeLimit for every task of a group to reply.
+         * A worker which doesn't reply in time, e.g. because a task never
+         * returns, is killed and the group fails without a retry.
+         *
+         * @param taskTimeLimit the limit, or 0 for no limit
+         */
+        void setTaskTimeLimit(std::chrono::milliseconds taskTimeLimit) {
+            this->taskTimeLimit = taskTimeLimit;
+        }
+
+        /**
+         * @brief Check whether this process is started as a worker.
+         *
+         * @return true if it's a worker
+         */
+        static bool isWorker() {
+            return std::getenv(WORKER_ENVIRONMENT) != nullptr;
+        }
+
+        /**
+         * @brief Execute the task groups in worker processes. Every group must be
+         * created by a TaskGroupRegistry. Return after all groups have finished.
+         *
+         * @param groups all groups to be executed
+         * @param workerCount how many worker processes run at the same time
+         * @return the groups which failed
+         */
+        std::vector<RemoteFailure> execute(const std::vector<Workflow::TaskGroup> &groups,
+            int workerCount) {
+            auto [groupSender, groupReceiver] = Channel<int>::create();
+            auto [failureSender, failureReceiver] = Channel<RemoteFailure>::create();
+
+            for (int i = 0; i < static_cast<int>(groups.size()); ++i)
+                groupSender.send(i);
+
+            groupSender.reset();
+
+            ThreadPool pool(workerCount);
+
+            for (int i = 0; i < workerCount; ++i) {
+                pool.execute<WorkerSlotRunner>(groups, groupReceiver.share(),
+                    failureSender.share(), maxRetryCount, taskTimeLimit);
+            }
+
+            failureSender.reset();
+            pool.stop();
+
+            std::vector<RemoteFailure> res;
+
+            while (auto failure = failureReceiver.receive())
+                res.push_back(std::move(failure.value()));
+
+            return res;
+        }
+
+        /**
+         * @brief Serve the coordinator in a worker process until it closes the
+         * connection. Each group is created by registry and executed by a TaskExecutor.
+         * Throw WorkerEnvironmentInvalidException if isWorker() is false.
+         *
+         * @param registry the registry which creates the groups
+         * @param parallelCount how many tasks of one group can be executed at the same time
+         * @param taskTimeLimit the limit of every task, or 0 for no limit
+         */
+        static void serve(const Workflow::TaskGroupRegistry &registry, int parallelCount = 1,
+            std::chrono::milliseconds taskTimeLimit = std::chrono::milliseconds(0)) {
+            const char *variable = std::getenv(WORKER_ENVIRONMENT);
+            char *end = nullptr;
+            long fd = (variable != nullptr ? std::strtol(variable, &end, 10) : -1);
+
+            if (variable == nullptr || end == variable || *end != '\0' || fd < 0 || fd > INT_MAX)
+                throw WorkerEnvironmentInvalidException();
+
+            Connection connection(static_cast<int>(fd));
+            /** Don't leak the socket to the processes started by tasks. */
+            ::fcntl(connection.getHandle(), F_SETFD, FD_CLOEXEC);
+            ::unsetenv(WORKER_ENVIRONMENT);
+
+            while (auto message = connection.receive()) {
+                MessageWriter reply;
+
+                try {
+                    auto descriptor = GroupDescriptor::decode(message.value());
+                    std::vector<Workflow::TaskGroup> groups;
+                    groups.push_back(registry.create(descriptor.type, descriptor.createArgument()));
+                    TaskExecutor executor;
+                    executor.setTaskTimeLimit(taskTimeLimit);
+                    auto failures = executor.execute(groups, parallelCount);
+
+                    if (failures.empty())
+                        reply.write("ok");
+                    else
+                        reply.write("error").write(failures.front().reason);
+                } catch (const std::exception &e) {
+                    reply.write("error").write(e.what());
+                }
+
+                if (!connection.send(reply.str()))
+                    break;
+            }
+        }
+    private:
+        int maxRetryCount;
+        std::chrono::milliseconds taskTimeLimit;
+    };
+} // namespace MultiGenerator::Executor
\ No newline at end of file
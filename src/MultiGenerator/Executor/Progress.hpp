@@ -0,0 +1,414 @@
+/**
+ * @file MultiGenerator/Executor/Progress.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief The reporter of the progress and the throughput of an execution.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <optional>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include <MultiGenerator/Context/Stream.hpp>
+#include <MultiGenerator/Variable/Argument.hpp>
+#include <MultiGenerator/Workflow/TaskGroup.hpp>
+
+namespace MultiGenerator::Executor {
+    /**
+     * @brief How many tasks or groups of a part have finished.
+     *
+     */
+    struct ProgressCounter {
+        /** The stage index or the subtask ID. */
+        int id;
+        int completed;
+        int total;
+    };
+
+    /**
+     * @brief A snapshot of the progress of an execution.
+     *
+     */
+    struct Progress {
+        int completed = 0;
+        int total = 0;
+        /** The finished tasks of each stage index. */
+        std::vector<ProgressCounter> stages;
+        /** The finished groups of each subtask, empty if no group has a SubtaskArgument. */
+        std::vector<ProgressCounter> subtasks;
+        double elapsed = 0;
+        double casesPerSecond = 0;
+        double bytesPerSecond = 0;
+        /** The remaining seconds estimated by the cost hints, or std::nullopt if unknown. */
+        std::optional<double> eta;
+        bool isFinished = false;
+    };
+
+    /**
+     * @brief The destination of the progress reports.
+     *
+     */
+    class ProgressSink {
+    public:
+        ProgressSink() {}
+
+        virtual ~ProgressSink() {}
+
+        virtual void report(const Progress &progress) = 0;
+    };
+
+    /**
+     * @brief A sink which prints one line for every report.
+     *
+     */
+    class StreamProgressSink : public ProgressSink {
+    public:
+        StreamProgressSink(std::ostream &os = std::cerr) :
+            ProgressSink(),
+            os(os) {}
+
+        ~StreamProgressSink() {}
+
+        void report(const Progress &progress) override {
+            char line[256];
+            std::snprintf(line, sizeof(line), "[%d/%d] %.1f cases/s, %.2f MB/s", progress.completed,
+                progress.total, progress.casesPerSecond, progress.bytesPerSecond / (1 << 20));
+            os << line;
+
+            if (progress.isFinished) {
+                std::snprintf(line, sizeof(line), ", finished in %.1f s", progress.elapsed);
+                os << line;
+            } else if (progress.eta.has_value()) {
+                std::snprintf(line, sizeof(line), ", ETA %.1f s", progress.eta.value());
+                os << line;
+            }
+
+            for (const auto &subtask : progress.subtasks)
+                os << ", subtask " << subtask.id << " " << subtask.completed << "/" << subtask.total;
+
+            os << std::endl;
+        }
+    private:
+        std::ostream &os;
+    };
+
+    /**
+     * @brief A sink which replaces a file with the latest report in JSON, which
+     * is read by other programs such as dashboards. The file is written to a
+     * temporary file first and then renamed, so a reader never sees half of it.
+     *
+     */
+    class FileProgressSink : public ProgressSink {
+    public:
+        FileProgressSink(const std::string &fileName) :
+            ProgressSink(),
+            fileName(fileName) {}
+
+        ~FileProgressSink() {}
+
+        void report(const Progress &progress) override {
+            auto temporary = fileName + ".tmp";
+
+            {
+                std::ofstream ofs(temporary);
+
+                ofs << "{\"completed\":" << progress.completed << ",\"total\":" << progress.total
+                    << ",\"elapsed\":" << progress.elapsed << ",\"casesPerSecond\":" << progress.casesPerSecond
+                    << ",\"bytesPerSecond\":" << progress.bytesPerSecond << ",\"eta\":";
+
+                if (progress.eta.has_value())
+                    ofs << progress.eta.value();
+                else
+                    ofs << "null";
+
+                ofs << ",\"finished\":" << (progress.isFinished ? "true" : "false")
+                    << ",\"stages\":" << toJSON(progress.stages)
+                    << ",\"subtasks\":" << toJSON(progress.subtasks) << "}\n";
+
+                if (!ofs)
+                    return;
+            }
+
+            std::rename(temporary.c_str(), fileName.c_str());
+        }
+    private:
+        std::string fileName;
+
+        static std::string toJSON(const std::vector<ProgressCounter> &counters) {
+            std::string res = "[";
+
+            for (std::size_t i = 0; i < counters.size(); ++i) {
+                res += (i == 0 ? "{\"id\":" : ",{\"id\":") + std::to_string(counters[i].id)
+                    + ",\"completed\":" + std::to_string(counters[i].completed)
+                    + ",\"total\":" + std::to_string(counters[i].total) + "}";
+            }
+
+            return res + "]";
+        }
+    };
+
+    /**
+     * @brief A reporter which counts the finished tasks and groups of an execution
+     * and sends a Progress to its sink every interval from another thread. The
+     * counting only increases some atomic counters, so it's cheap enough for
+     * every task. An execution in several parts, such as the windows of a
+     * template, adds the groups of every part with extend().
+     *
+     */
+    class ProgressReporter {
+    public:
+        ProgressReporter(std::shared_ptr<ProgressSink> sink,
+            std::chrono::milliseconds interval = std::chrono::seconds(1)) :
+            sink(std::move(sink)),
+            interval(interval),
+            stageCompleted(),
+            stageTotal(),
+            subtaskCompleted(),
+            subtaskTotal(),
+            subtaskIDs(),
+            subtaskIndexes(),
+            groupSubtasks(),
+            groupCosts(),
+            groupOffset(0),
+            completed(0),
+            completedCost(0),
+            total(0),
+            totalCost(0),
+            startTime(),
+            startBytes(0),
+            counterMtx(),
+            isStopped(true),
+            mtx(),
+            cond(),
+            thread() {}
+
+        ProgressReporter(const ProgressReporter &) = delete;
+
+        ProgressReporter &operator=(const ProgressReporter &) = delete;
+
+        ~ProgressReporter() {
+            stop();
+        }
+
+        /**
+         * @brief Reset the counters by the groups and start reporting.
+         *
+         * @param groups all groups to be executed, or the first part of them
+         */
+        void start(const std::vector<Workflow::TaskGroup> &groups) {
+            stop();
+
+            {
+                std::lock_guard<std::mutex> lock(counterMtx);
+                stageCompleted.clear();
+                stageTotal.clear();
+                subtaskCompleted.clear();
+                subtaskTotal.clear();
+                subtaskIDs.clear();
+                subtaskIndexes.clear();
+                groupSubtasks.clear();
+                groupCosts.clear();
+                completed = 0;
+                completedCost = 0;
+                total = 0;
+                totalCost = 0;
+                startTime = std::chrono::steady_clock::now();
+                startBytes = Context::writtenByteCount.load(std::memory_order_relaxed);
+            }
+
+            extend(groups);
+
+            std::lock_guard<std::mutex> lock(mtx);
+            isStopped = false;
+            thread = std::thread([this]() {
+                loop();
+            });
+        }
+
+        /**
+         * @brief Add the groups of the next part of the execution to the totals.
+         * The IDs given to finishGroup() are the indexes in groups from now on.
+         * Call it while no task of the execution is running.
+         *
+         * @param groups the groups of the next part
+         */
+        void extend(const std::vector<Workflow::TaskGroup> &groups) {
+            std::lock_guard<std::mutex> lock(counterMtx);
+            groupOffset = groupSubtasks.size();
+
+            for (const auto &group : groups) {
+                for (int j = 0; j < group.getStageCount(); ++j) {
+                    if (j >= static_cast<int>(stageTotal.size())) {
+                        stageTotal.push_back(0);
+                        stageCompleted.emplace_back(0);
+                    }
+
+                    auto [first, last] = group.getStageRange(j);
+                    stageTotal[j] += last - first;
+                }
+
+                int subtask = -1;
+                auto argument = std::dynamic_pointer_cast<Variable::SubtaskArgument>(group.getArgument());
+
+                if (argument) {
+                    auto [it, isInserted] = subtaskIndexes.emplace(argument->getSubtask(),
+                        static_cast<int>(subtaskIDs.size()));
+
+                    if (isInserted) {
+                        subtaskIDs.push_back(argument->getSubtask());
+                        subtaskTotal.push_back(0);
+                        subtaskCompleted.emplace_back(0);
+                    }
+
+                    subtask = it->second;
+                    ++subtaskTotal[subtask];
+                }
+
+                groupSubtasks.push_back(subtask);
+                groupCosts.push_back(group.getCostHint());
+                totalCost += group.getCostHint();
+            }
+
+            total += static_cast<int>(groups.size());
+        }
+
+        /**
+         * @brief Check whether it's reporting, i.e. started and not stopped.
+         *
+         */
+        bool isRunning() {
+            std::lock_guard<std::mutex> lock(mtx);
+            return !isStopped;
+        }
+
+        /**
+         * @brief Stop reporting and send the final report.
+         *
+         */
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+
+                if (isStopped)
+                    return;
+
+                isStopped = true;
+            }
+
+            cond.notify_all();
+            thread.join();
+            auto progress = getProgress();
+            progress.isFinished = true;
+            progress.eta = 0;
+            sink->report(progress);
+        }
+
+        /**
+         * @brief Count a finished task. It's called by the workers.
+         *
+         * @param group the group of the task
+         * @param taskID the ID of the task in the group
+         */
+        void finishTask(const Workflow::TaskGroup &group, int taskID) {
+            stageCompleted[group.getStage(taskID)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Count a finished group, including a cancelled one.
+         *
+         * @param id the index of the group in the last part
+         */
+        void finishGroup(int id) {
+            auto index = groupOffset + static_cast<std::size_t>(id);
+
+            if (groupSubtasks[index] >= 0)
+                subtaskCompleted[groupSubtasks[index]].fetch_add(1, std::memory_order_relaxed);
+
+            completedCost.store(completedCost.load(std::memory_order_relaxed) + groupCosts[index],
+                std::memory_order_relaxed);
+            completed.fetch_add(1, std::memory_order_release);
+        }
+
+        Progress getProgress() const {
+            std::lock_guard<std::mutex> lock(counterMtx);
+            Progress res;
+            res.completed = completed.load(std::memory_order_acquire);
+            res.total = total;
+            res.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+            for (std::size_t i = 0; i < stageTotal.size(); ++i)
+                res.stages.push_back({ static_cast<int>(i), stageCompleted[i].load(std::memory_order_relaxed), stageTotal[i] });
+
+            for (std::size_t i = 0; i < subtaskTotal.size(); ++i)
+                res.subtasks.push_back({ subtaskIDs[i], subtaskCompleted[i].load(std::memory_order_relaxed), subtaskTotal[i] });
+
+            if (res.elapsed > 0) {
+                res.casesPerSecond = res.completed / res.elapsed;
+                res.bytesPerSecond = static_cast<double>(
+                    Context::writtenByteCount.load(std::memory_order_relaxed) - startBytes) / res.elapsed;
+            }
+
+            double cost = completedCost.load(std::memory_order_relaxed);
+
+            if (cost > 0)
+                res.eta = (totalCost - cost) * res.elapsed / cost;
+
+            return res;
+        }
+    private:
+        std::shared_ptr<ProgressSink> sink;
+        std::chrono::milliseconds interval;
+        /** Deques, so that the counters stay in place when more are added. */
+        std::deque<std::atomic_int> stageCompleted;
+        std::vector<int> stageTotal;
+        std::deque<std::atomic_int> subtaskCompleted;
+        std::vector<int> subtaskTotal;
+        std::vector<int> subtaskIDs;
+        /** The indexes in subtaskIDs by the subtask IDs. */
+        std::map<int, int> subtaskIndexes;
+        /** The index of the subtask of each group, or -1. */
+        std::vector<int> groupSubtasks;
+        std::vector<double> groupCosts;
+        /** Where the groups of the last part begin. */
+        std::size_t groupOffset;
+        std::atomic_int completed;
+        /** Only changed by the thread which counts the groups. */
+        std::atomic<double> completedCost;
+        int total;
+        double totalCost;
+        std::chrono::steady_clock::time_point startTime;
+        long long startBytes;
+        /** Guards the shapes of the counters against extend() while reporting. */
+        mutable std::mutex counterMtx;
+        bool isStopped;
+        std::mutex mtx;
+        std::condition_variable cond;
+        std::thread thread;
+
+        void loop() {
+            std::unique_lock<std::mutex> lock(mtx);
+
+            while (!cond.wait_for(lock, interval, [this]() { return isStopped; })) {
+                lock.unlock();
+                sink->report(getProgress());
+                lock.lock();
+            }
+        }
+    };
+} // namespace MultiGenerator::Executor
@@ -0,0 +1,166 @@
+/**
+ * @file MultiGenerator/Executor/Protocol.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief The messages transferred between the coordinator and the workers.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <exception>
+
+#include <MultiGenerator/Variable/Argument.hpp>
+#include <MultiGenerator/Variable/DataConfig.hpp>
+#include <MultiGenerator/Workflow/TaskGroup.hpp>
+
+namespace MultiGenerator::Executor {
+    class MessageInvalidException : public std::exception {
+    public:
+        const char *what() const noexcept override {
+            return "MessageInvalidException: The message is truncated or malformed.";
+        }
+    };
+
+    /**
+     * @brief A helper which encodes fields into a message. Every field is
+     * written as its length, a colon and its content.
+     *
+     */
+    class MessageWriter {
+    public:
+        MessageWriter() :
+            message() {}
+
+        ~MessageWriter() {}
+
+        MessageWriter &write(const std::string &field) {
+            message += std::to_string(field.size());
+            message += ':';
+            message += field;
+            return *this;
+        }
+
+        MessageWriter &write(long long field) {
+            return write(std::to_string(field));
+        }
+
+        const std::string &str() const {
+            return message;
+        }
+    private:
+        std::string message;
+    };
+
+    /**
+     * @brief A helper which decodes fields from a message written by MessageWriter.
+     * Throw if the message is malformed.
+     *
+     */
+    class MessageReader {
+    public:
+        MessageReader(std::string message) :
+            message(std::move(message)),
+            position(0) {}
+
+        ~MessageReader() {}
+
+        std::string readString() {
+            auto colon = message.find(':', position);
+
+            if (colon == std::string::npos)
+                throw MessageInvalidException();
+
+            std::size_t size = static_cast<std::size_t>(readNumber(message.substr(position, colon - position)));
+
+            if (colon + 1 + size > message.size())
+                throw MessageInvalidException();
+
+            position = colon + 1 + size;
+            return message.substr(colon + 1, size);
+        }
+
+        long long readInteger() {
+            return readNumber(readString());
+        }
+    private:
+        std::string message;
+        std::size_t position;
+
+        static long long readNumber(const std::string &str) {
+            try {
+                std::size_t pos = 0;
+                long long res = std::stoll(str, &pos);
+
+                if (pos == str.size())
+                    return res;
+            } catch (const std::logic_error &) {}
+
+            throw MessageInvalidException();
+        }
+    };
+
+    /**
+     * @brief Everything a worker needs to create a task group again: the index
+     * in the coordinator, the registered type, the argument ID and the config.
+     *
+     */
+    struct GroupDescriptor {
+        int index;
+        std::string type;
+        std::string argument;
+        std::vector<std::pair<std::string, std::string>> config;
+
+        static GroupDescriptor create(int index, const Workflow::TaskGroup &group) {
+            GroupDescriptor res{ index, group.getType(), group.getArgument()->getID(), {} };
+
+            group.getArgument()->getConfig().forEach([&res](const auto &key, const auto &value) {
+                res.config.emplace_back(key, value);
+            });
+
+            return res;
+        }
+
+        std::string encode() const {
+            MessageWriter writer;
+            writer.write(index).write(type).write(argument);
+            writer.write(static_cast<long long>(config.size()));
+
+            for (const auto &[key, value] : config)
+                writer.write(key).write(value);
+
+            return writer.str();
+        }
+
+        static GroupDescriptor decode(const std::string &message) {
+            MessageReader reader(message);
+            GroupDescriptor res;
+            res.index = static_cast<int>(reader.readInteger());
+            res.type = reader.readString();
+            res.argument = reader.readString();
+            auto size = reader.readInteger();
+
+            for (long long i = 0; i < size; ++i) {
+                auto key = reader.readString();
+                auto value = reader.readString();
+                res.config.emplace_back(std::move(key), std::move(value));
+            }
+
+            return res;
+        }
+
+        std::shared_ptr<Variable::Argument> createArgument() const {
+            Variable::DataConfig res;
+
+            for (const auto &[key, value] : config)
+                res.change(key, value);
+
+            return Variable::parseArgument(argument, res);
+        }
+    };
+} // namespace MultiGenerator::Executor
\ No newline at end of file
@@ -0,0 +1,206 @@
+/**
+ * @file MultiGenerator/Executor/Socket.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief A connection which transfers messages over a Unix domain socket.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <string>
+#include <optional>
+#include <utility>
+#include <chrono>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+namespace MultiGenerator::Executor {
+    /**
+     * @brief The owner of one end of a stream socket which transfers messages.
+     * Every message is prefixed with its length.
+     *
+     */
+    class Connection {
+    public:
+        Connection() :
+            fd(-1) {}
+
+        explicit Connection(int fd) :
+            fd(fd) {}
+
+        Connection(const Connection &) = delete;
+
+        Connection(Connection &&rhs) :
+            fd(std::exchange(rhs.fd, -1)) {}
+
+        Connection &operator=(const Connection &) = delete;
+
+        Connection &operator=(Connection &&rhs) {
+            if (this != &rhs) {
+                close();
+                fd = std::exchange(rhs.fd, -1);
+            }
+
+            return *this;
+        }
+
+        ~Connection() {
+            close();
+        }
+
+        /**
+         * @brief Create a pair of connected connections.
+         *
+         * @return the pair or std::nullopt if failed
+         */
+        static std::optional<std::pair<Connection, Connection>> createPair() {
+            int fds[2];
+
+            if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0)
+                return std::nullopt;
+
+            return std::make_pair(Connection(fds[0]), Connection(fds[1]));
+        }
+
+        bool isOpen() const {
+            return fd >= 0;
+        }
+
+        int getHandle() const {
+            return fd;
+        }
+
+        /**
+         * @brief Release the ownership of the socket.
+         *
+         * @return the file descriptor
+         */
+        int release() {
+            return std::exchange(fd, -1);
+        }
+
+        void close() {
+            if (fd >= 0)
+                ::close(fd);
+
+            fd = -1;
+        }
+
+        /**
+         * @brief Send a message. Return false if the peer has gone.
+         *
+         * @param message the message
+         * @return false if failed
+         */
+        bool send(const std::string &message) {
+            std::uint64_t size = message.size();
+            char header[sizeof(size)];
+
+            for (std::size_t i = 0; i < sizeof(size); ++i)
+                header[i] = static_cast<char>((size >> (i * 8)) & 0xff);
+
+            return sendAll(header, sizeof(header)) && sendAll(message.data(), message.size());
+        }
+
+        /**
+         * @brief Receive a message. Keep waiting until a whole message arrives or
+         * the deadline passes.
+         *
+         * @param deadline when to give up
+         * @return the message or std::nullopt if the peer has gone or it's too late
+         */
+        std::optional<std::string> receive(
+            std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()) {
+            unsigned char header[sizeof(std::uint64_t)];
+
+            if (!receiveAll(reinterpret_cast<char *>(header), sizeof(header), deadline))
+                return std::nullopt;
+
+            std::uint64_t size = 0;
+
+            for (std::size_t i = 0; i < sizeof(size); ++i)
+                size |= static_cast<std::uint64_t>(header[i]) << (i * 8);
+
+            std::string message(size, '\0');
+
+            if (!receiveAll(message.data(), message.size(), deadline))
+                return std::nullopt;
+
+            return message;
+        }
+    private:
+        int fd;
+
+        bool sendAll(const char *data, std::size_t size) {
+            while (size != 0) {
+                /** MSG_NOSIGNAL prevents SIGPIPE when the peer has crashed. */
+                ssize_t res = ::send(fd, data, size, MSG_NOSIGNAL);
+
+                if (res < 0) {
+                    if (errno == EINTR)
+                        continue;
+
+                    return false;
+                }
+
+                data += res;
+                size -= static_cast<std::size_t>(res);
+            }
+
+            return true;
+        }
+
+        bool receiveAll(char *data, std::size_t size, std::chrono::steady_clock::time_point deadline) {
+            while (size != 0) {
+                if (deadline != std::chrono::steady_clock::time_point::max() && !waitReadable(deadline))
+                    return false;
+
+                ssize_t res = ::recv(fd, data, size, 0);
+
+                if (res < 0 && errno == EINTR)
+                    continue;
+
+                if (res <= 0)
+                    return false;
+
+                data += res;
+                size -= static_cast<std::size_t>(res);
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Wait until there is something to read.
+         *
+         * @return false if the deadline has passed first
+         */
+        bool waitReadable(std::chrono::steady_clock::time_point deadline) {
+            while (true) {
+                auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now());
+
+                if (remaining.count() <= 0)
+                    return false;
+
+                pollfd item{ fd, POLLIN, 0 };
+                int res = ::poll(&item, 1, static_cast<int>(std::min<long long>(remaining.count(), 1 << 30)));
+
+                if (res > 0)
+                    return true;
+
+                if (res < 0 && errno != EINTR)
+                    return false;
+            }
+        }
+    };
+} // namespace MultiGenerator::Executor
\ No newline at end of file
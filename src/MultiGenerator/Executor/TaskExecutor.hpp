@@ -12,14 +12,179 @@
 
 #include <memory>
 #include <vector>
+#include <list>
+#include <deque>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
 
+#include <MultiGenerator/Context/Trace.hpp>
+#include <MultiGenerator/Context/Memory.hpp>
 #include <MultiGenerator/Workflow/Runner.hpp>
 #include <MultiGenerator/Workflow/Task.hpp>
 #include <MultiGenerator/Workflow/TaskGroup.hpp>
+#include <MultiGenerator/Workflow/Function.hpp>
 #include <MultiGenerator/Executor/Channel.hpp>
 #include <MultiGenerator/Executor/ThreadPool.hpp>
+#include <MultiGenerator/Executor/Allocator.hpp>
+#include <MultiGenerator/Executor/Failure.hpp>
+#include <MultiGenerator/Executor/Watchdog.hpp>
+#include <MultiGenerator/Executor/Progress.hpp>
 
 namespace MultiGenerator::Executor {
+    /**
+     * @brief Everything shared by the runners of one execution. It's kept by the
+     * executor until all runners have finished.
+     *
+     */
+    struct RunContext {
+        FailureCollector &collector;
+        /** nullptr if the tasks have no time limit. */
+        Watchdog *watchdog;
+        std::chrono::milliseconds timeLimit;
+        /** nullptr if the progress isn't reported. */
+        ProgressReporter *reporter;
+        /** nullptr if the tasks record into the profile of their thread. */
+        Context::MemoryProfile *memoryProfile;
+    };
+
+    /**
+     * @brief Create a task of a group and execute it. An exception thrown by the
+     * task is reported to the collector. With a watchdog, the task fails with
+     * TaskTimeoutException after the time limit, which cancels its group so that
+     * the task can stop early. The memory scopes of the task record into the
+     * profile of the execution. The task is destroyed before returning, which
+     * closes its files.
+     *
+     */
+    inline void executeTask(const Workflow::TaskGroup &group, int taskID, const RunContext &context) {
+        auto &collector = context.collector;
+        Watchdog::Handle handle = -1;
+
+        if (context.watchdog) {
+            handle = context.watchdog->watch(context.timeLimit,
+                [&group, taskID, &collector, timeLimit = context.timeLimit]() {
+                collector.fail(group, taskID, std::make_exception_ptr(TaskTimeoutException(timeLimit)));
+            });
+        }
+
+        try {
+            Context::MemoryProfileBinding binding(context.memoryProfile);
+            std::unique_ptr<Workflow::Task> task;
+
+            {
+                MULTIGENERATOR_TRACE_SCOPE(scope, "construct", "task");
+                MULTIGENERATOR_TRACE_ARGUMENT(scope, "testcase", group.getArgument()->getID());
+                MULTIGENERATOR_TRACE_ARGUMENT(scope, "task", std::to_string(taskID));
+                task = group.createTask(taskID);
+            }
+
+            task->setRunToken(collector.getRunToken());
+            task->call();
+        } catch (...) {
+            collector.fail(group, taskID, std::current_exception());
+        }
+
+        if (context.watchdog)
+            context.watchdog->unwatch(handle);
+
+        if (context.reporter)
+            context.reporter->finishTask(group, taskID);
+    }
+
+    /**
+     * @brief A runner which creates a task of a TaskGroup lazily, executes it,
+     * destroys it and then calls a function to report the completion. An
+     * exception thrown by the task is reported to a FailureCollector.
+     *
+     */
+    class TaskRunner : public Workflow::Runner {
+    public:
+        TaskRunner(const Workflow::TaskGroup &group, int taskID, const RunContext &context,
+            Workflow::SmallFunction<void()> after) :
+            Workflow::Runner(),
+            group(group),
+            taskID(taskID),
+            context(context),
+            after(std::move(after)) {}
+
+        ~TaskRunner() {}
+    private:
+        /** The group and the context are kept by the executor, which outlives the runner. */
+        const Workflow::TaskGroup &group;
+        int taskID;
+        const RunContext &context;
+        Workflow::SmallFunction<void()> after;
+
+        void run() override {
+            executeTask(group, taskID, context);
+            after();
+        }
+    };
+
+    /**
+     * @brief A runner which executes the rest of several sequential task groups
+     * to the last stage, and reports each group as soon as it finishes.
+     * It's used to save the cost of scheduling very small groups.
+     *
+     */
+    class BatchRunner : public Workflow::Runner {
+    public:
+        BatchRunner(const std::vector<Workflow::TaskGroup> &groups, std::vector<int> ids,
+            Sender<int> sender, const RunContext &context, std::atomic<long long> &groupCost) :
+            Workflow::Runner(),
+            groups(groups),
+            ids(std::move(ids)),
+            sender(std::move(sender)),
+            context(context),
+            groupCost(groupCost) {}
+
+        ~BatchRunner() {}
+    private:
+        const std::vector<Workflow::TaskGroup> &groups;
+        std::vector<int> ids;
+        Sender<int> sender;
+        const RunContext &context;
+        /** The average time in nanoseconds which a group takes, shared by all batches. */
+        std::atomic<long long> &groupCost;
+
+        void run() override {
+            for (int id : ids) {
+                const auto &group = groups[id];
+                auto start = std::chrono::steady_clock::now();
+                /** Skip the groups left in this batch after the run is cancelled. */
+                if (context.collector.getRunToken().isCancelled())
+                    group.cancel();
+
+                while (true) {
+                    auto [first, last] = group.nextStageRange();
+
+                    if (first == last)
+                        break;
+
+                    executeTask(group, first, context);
+                }
+
+                measure(std::chrono::steady_clock::now() - start);
+                /** The executor finds no stage left and releases the group. */
+                sender.send(id);
+            }
+        }
+
+        /**
+         * @brief Update the average time of a group before reporting it, so that
+         * the executor knows it when the report arrives. The time is smoothed
+         * so that one slow group doesn't change the batch size much.
+         *
+         */
+        void measure(std::chrono::steady_clock::duration elapsed) {
+            long long cost = std::max<long long>(1,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            long long old = groupCost.load(std::memory_order_relaxed);
+            groupCost.store(old == 0 ? cost : (old * 7 + cost) / 8, std::memory_order_relaxed);
+        }
+    };
+
     /**
      * @brief A executor which schedules the running of tasks.
      * 
@@ -27,61 +192,372 @@ namespace MultiGenerator::Executor {
     class TaskExecutor {
     public:
         TaskExecutor() :
-            pool() {}
+            runnerPool(),
+            pool(),
+            ioPool(),
+            ioParallelCount(0),
+            maxParallelCount(0),
+            idleTimeout(0),
+            memoryBudget(0),
+            maxActiveGroupCount(0),
+            batchGranularity(0),
+            failurePolicy(FailurePolicy::ContinueAndReport),
+            taskTimeLimit(0),
+            watchdog(),
+            progressReporter(),
+            memoryProfile(),
+            groupCost(0),
+            batchCount(0) {}
 
         ~TaskExecutor() {}
 
+        /**
+         * @brief Let the pool add workers when tasks are blocked on I/O, up to
+         * maxParallelCount in total. The extra workers quit after being idle for
+         * idleTimeout.
+         *
+         * @param maxParallelCount how many task can be executed at most
+         * @param idleTimeout how long an extra worker waits before quitting
+         */
+        void setElasticity(int maxParallelCount, std::chrono::milliseconds idleTimeout) {
+            this->maxParallelCount = maxParallelCount;
+            this->idleTimeout = idleTimeout;
+        }
+
+        /**
+         * @brief Execute the tasks of ResourceClass::IO by another ioParallelCount
+         * worker(s), so that they don't take the slots of the CPU tasks.
+         * 
+         * @param ioParallelCount how many I/O tasks can be executed at the same
+         * time, or 0 to execute them with the CPU tasks
+         */
+        void setIOParallelCount(int ioParallelCount) {
+            this->ioParallelCount = ioParallelCount;
+        }
+
+        /**
+         * @brief Start a group only while the total estimated memory of the running
+         * groups stays under memoryBudget. The groups after a large one which
+         * doesn't fit may start first. A group larger than the budget runs alone.
+         * 
+         * @param memoryBudget the budget in bytes, or 0 for no limit
+         */
+        void setMemoryBudget(std::size_t memoryBudget) {
+            this->memoryBudget = memoryBudget;
+        }
+
+        /**
+         * @brief Limit how many groups run at the same time, which also limits
+         * how many generated inputs are waiting for their solutions.
+         * 
+         * @param maxActiveGroupCount the count, or 0 for no limit
+         */
+        void setMaxActiveGroupCount(int maxActiveGroupCount) {
+            this->maxActiveGroupCount = maxActiveGroupCount;
+        }
+
+        /**
+         * @brief Pack several small sequential groups into one runner, so that a
+         * runner takes about batchGranularity. The time of a group is measured
+         * while executing. Every group still has its own tasks and files. The
+         * groups are packed when the rest of their stages is sequential. If the
+         * I/O pool is used, that is after their last task of ResourceClass::IO,
+         * so that the I/O tasks still go to the pool.
+         * 
+         * @param batchGranularity the target time of a runner, or 0 to disable it
+         */
+        void setBatchGranularity(std::chrono::nanoseconds batchGranularity) {
+            this->batchGranularity = batchGranularity;
+        }
+
+        /**
+         * @brief Choose what to do after a task throws. Its group is always
+         * cancelled. With FailurePolicy::FailFast, the groups which haven't
+         * finished are cancelled too and only the running tasks are waited for.
+         * 
+         * @param failurePolicy the policy
+         */
+        void setFailurePolicy(FailurePolicy failurePolicy) {
+            this->failurePolicy = failurePolicy;
+        }
+
+        /**
+         * @brief Give every task taskTimeLimit to run. A task running longer fails
+         * with TaskTimeoutException, and its group is cancelled. A task can't be
+         * stopped from outside, so it keeps its worker until it checks the
+         * cancellation or returns. An external solution is killed at once.
+         * 
+         * @param taskTimeLimit the limit, or 0 for no limit
+         */
+        void setTaskTimeLimit(std::chrono::milliseconds taskTimeLimit) {
+            this->taskTimeLimit = taskTimeLimit;
+        }
+
+        /**
+         * @brief Count the finished tasks and groups with progressReporter, which
+         * reports the progress from its own thread during execute(). If it's
+         * already running, execute() adds its groups to it and doesn't stop it,
+         * so that several executions are reported as one.
+         * 
+         * @param progressReporter the reporter, or nullptr to report nothing
+         */
+        void setProgressReporter(std::shared_ptr<ProgressReporter> progressReporter) {
+            this->progressReporter = std::move(progressReporter);
+        }
+
+        /**
+         * @brief Make the memory scopes of the tasks record into memoryProfile,
+         * so that concurrent executions keep their records apart.
+         * 
+         * @param memoryProfile the profile, or nullptr to record into the
+         * profile of the thread running each task
+         */
+        void setMemoryProfile(std::shared_ptr<Context::MemoryProfile> memoryProfile) {
+            this->memoryProfile = std::move(memoryProfile);
+        }
+
+        /**
+         * @brief Get how many batches have been posted, which is used to check
+         * the effect of setBatchGranularity().
+         * 
+         */
+        int getBatchCount() const {
+            return batchCount;
+        }
+
         /**
          * @brief Execute the task groups parallel. Return after all tasks have finished.
          * 
          * @param groups all tasks to be executed
          * @param parallelCount how many task can be executed at the same time
+         * @return the groups which failed
          */
-        void execute(const std::vector<Workflow::TaskGroup> &groups, int parallelCount) {
+        std::vector<Failure> execute(const std::vector<Workflow::TaskGroup> &groups, int parallelCount) {
+            FailureCollector collector(failurePolicy);
+            const auto &runToken = collector.getRunToken();
             auto channel = Channel<int>::create();
             auto taskSender = std::move(channel.first);
             auto taskReceiver = std::move(channel.second);
-            
+            /** The groups which haven't started yet. */
+            std::list<int> waiting;
+
             for (int i = 0; i < static_cast<int>(groups.size()); ++i)
-                taskSender.send(i);
+                waiting.push_back(i);
 
-            taskSender.reset();
+            std::size_t usedMemory = 0;
+            int activeCount = 0;
+            admit(groups, waiting, usedMemory, activeCount, taskSender, runToken);
 
-            pool.start(parallelCount);
+            if (maxParallelCount > parallelCount)
+                pool.start(parallelCount, maxParallelCount, idleTimeout);
+            else
+                pool.start(parallelCount);
+
+            if (ioParallelCount > 0)
+                ioPool.start(ioParallelCount);
+
+            if (taskTimeLimit.count() > 0)
+                watchdog.start();
+
+            /** A reporter started by the caller counts this execution as a part of its own. */
+            bool isReporting = (progressReporter && !progressReporter->isRunning());
+
+            if (isReporting)
+                progressReporter->start(groups);
+            else if (progressReporter)
+                progressReporter->extend(groups);
+
+            RunContext context{ collector, (taskTimeLimit.count() > 0 ? &watchdog : nullptr),
+                taskTimeLimit, progressReporter.get(), memoryProfile.get() };
+
+            /** How many tasks of the current stage of each group are still running. */
+            std::vector<int> remaining(groups.size(), 0);
+            std::vector<bool> batched(groups.size(), false);
+            groupCost = 0;
+            batchCount = 0;
+            /** The small groups waiting to be packed into runners. */
+            std::deque<int> batchable;
 
             while (true) {
-                auto nextGroupID = taskReceiver.receive();
+                /** Wait for the time of a group to be measured before packing more. */
+                bool isMeasuring = (groupCost.load(std::memory_order_relaxed) == 0
+                    && batchCount >= parallelCount);
+                auto nextGroupID = (batchable.empty() || isMeasuring ? taskReceiver.receive()
+                    : taskReceiver.receiveFor(std::chrono::nanoseconds(0)));
                 /** If all task have finished, the channel will close and return std::nullopt. */
-                if (!nextGroupID.has_value())
-                    break;
-                /** Get the next task. */
+                if (!nextGroupID.has_value()) {
+                    if (batchable.empty())
+                        break;
+                    /** No more group comes at once, so post the incomplete batches too. */
+                    dispatchBatches(groups, batchable, true, parallelCount, taskReceiver, context);
+                    continue;
+                }
+
                 int id = nextGroupID.value();
-                auto task = groups[id].next();
+                /** Wait for the other tasks of the same stage. */
+                if (remaining[id] > 0 && --remaining[id] > 0)
+                    continue;
+                /** Pack the rest of the group once it's small enough, e.g. after its I/O stages. */
+                if (!batched[id] && batchGranularity.count() != 0 && isBatchable(groups[id])) {
+                    batched[id] = true;
+                    batchable.push_back(id);
+                    dispatchBatches(groups, batchable, false, parallelCount, taskReceiver, context);
+                    continue;
+                }
+                /** Start no more stages after the run is cancelled. */
+                if (runToken.isCancelled())
+                    groups[id].cancel();
+                /** Get the next stage. */
+                auto [first, last] = groups[id].nextStageRange();
                 /** All task in this task group have finished. */
-                if (!task.has_value())
+                if (first == last) {
+                    groups[id].getArgument()->releaseSharedInputs();
+
+                    if (progressReporter)
+                        progressReporter->finishGroup(id);
+
+                    usedMemory -= groups[id].getMemoryEstimate();
+                    --activeCount;
+                    admit(groups, waiting, usedMemory, activeCount, taskSender, runToken);
                     continue;
+                }
+
+                remaining[id] = last - first;
 
-                auto sender = std::make_shared<Sender<int>>(Channel<int>::open(taskReceiver));
-                auto lambda = [id, sender](auto cont) mutable {
-                    /** Notify this executor to get the next task of groups[id] */
-                    auto notify = [id, sender]() mutable {
-                        sender->send(id);
-                    };
-
-                    std::unique_ptr<Workflow::Callable> callable = cont();
-                    /** Use AfterCallableWrapper to notify the executor after task finished. */
-                    return std::make_unique<Workflow::AfterCallableWrapper>(
-                        std::move(callable), notify);
-                };
-
-                /** Use LazyInitRunner to create a Task object lazily to save system resource. */
-                auto cont = std::bind(std::move(lambda), std::move(task.value().constructor));
-                pool.execute<Workflow::LazyInitRunner>(std::move(cont));
+                for (int i = first; i < last; ++i)
+                    dispatch(groups, id, i, taskReceiver, context);
             }
 
             pool.stop();
+
+            if (ioParallelCount > 0)
+                ioPool.stop();
+
+            watchdog.stop();
+
+            if (isReporting)
+                progressReporter->stop();
+
+            return collector.getFailures();
         }
     private:
+        /** Declared first so that it's destroyed after the runners in the pools. */
+        BlockPool runnerPool;
         ThreadPool pool;
+        ThreadPool ioPool;
+        int ioParallelCount;
+        int maxParallelCount;
+        std::chrono::milliseconds idleTimeout;
+        std::size_t memoryBudget;
+        int maxActiveGroupCount;
+        std::chrono::nanoseconds batchGranularity;
+        FailurePolicy failurePolicy;
+        std::chrono::milliseconds taskTimeLimit;
+        Watchdog watchdog;
+        std::shared_ptr<ProgressReporter> progressReporter;
+        std::shared_ptr<Context::MemoryProfile> memoryProfile;
+        std::atomic<long long> groupCost;
+        int batchCount;
+
+        static constexpr int MAX_BATCH_SIZE = 64;
+
+        /**
+         * @brief Post the batchable groups in batches of the size which fits in the
+         * granularity by their measured time. Until the time is known, only
+         * parallelCount groups are posted one by one to measure it.
+         * 
+         * @param isComplete whether to post the last incomplete batch
+         */
+        void dispatchBatches(const std::vector<Workflow::TaskGroup> &groups, std::deque<int> &batchable,
+            bool isComplete, int parallelCount, Receiver<int> &taskReceiver, const RunContext &context) {
+            while (!batchable.empty()) {
+                long long cost = groupCost.load(std::memory_order_relaxed);
+                std::size_t size = 1;
+
+                if (cost != 0)
+                    size = static_cast<std::size_t>(std::clamp<long long>(
+                        batchGranularity.count() / cost, 1, MAX_BATCH_SIZE));
+                else if (batchCount >= parallelCount && !isComplete)
+                    break;
+
+                if (batchable.size() < size && !isComplete)
+                    break;
+
+                size = std::min(size, batchable.size());
+                std::vector<int> ids(batchable.begin(), batchable.begin() + static_cast<long>(size));
+                batchable.erase(batchable.begin(), batchable.begin() + static_cast<long>(size));
+                pool.execute<BatchRunner>(groups, std::move(ids), Channel<int>::open(taskReceiver),
+                    context, groupCost);
+                ++batchCount;
+            }
+        }
+
+        /**
+         * @brief Start the waiting groups which fit in the budget. Close the sender
+         * after all groups have started, so that the channel closes when the last
+         * task finishes. Drop all waiting groups after the run is cancelled.
+         * 
+         */
+        void admit(const std::vector<Workflow::TaskGroup> &groups, std::list<int> &waiting,
+            std::size_t &usedMemory, int &activeCount, Sender<int> &taskSender,
+            const Workflow::CancellationToken &runToken) {
+            if (runToken.isCancelled()) {
+                for (int id : waiting)
+                    groups[id].cancel();
+
+                waiting.clear();
+            }
+
+            for (auto it = waiting.begin(); it != waiting.end();) {
+                if (maxActiveGroupCount != 0 && activeCount >= maxActiveGroupCount)
+                    break;
+
+                auto memory = groups[*it].getMemoryEstimate();
+                /** Let the smaller groups behind fill the gap. */
+                if (memoryBudget != 0 && activeCount != 0 && usedMemory + memory > memoryBudget) {
+                    ++it;
+                    continue;
+                }
+
+                usedMemory += memory;
+                ++activeCount;
+                taskSender.send(*it);
+                it = waiting.erase(it);
+            }
+
+            if (waiting.empty())
+                taskSender.reset();
+        }
+
+        /**
+         * @brief Check whether the rest of a group can be executed in a BatchRunner,
+         * which runs its tasks one by one on the CPU pool. It mustn't have an I/O
+         * task while the I/O pool is used, so that the task goes to the pool.
+         * 
+         */
+        bool isBatchable(const Workflow::TaskGroup &group) const {
+            return group.isSequential()
+                && !(ioParallelCount > 0 && group.hasResourceClass(Workflow::ResourceClass::IO));
+        }
+
+        /**
+         * @brief Post a task. The runner and its reference count are put in a
+         * reused block and the notification is stored inside the runner, so that
+         * nothing is allocated here once the pool has warmed up.
+         * 
+         */
+        void dispatch(const std::vector<Workflow::TaskGroup> &groups, int id, int taskID,
+            Receiver<int> &taskReceiver, const RunContext &context) {
+            /** Notify this executor to get the next task of groups[id]. */
+            auto notify = [id, sender = Channel<int>::open(taskReceiver)]() mutable {
+                sender.send(id);
+            };
+
+            const auto &task = groups[id].getEntry(taskID);
+            auto runner = std::allocate_shared<TaskRunner>(PoolAllocator<TaskRunner>(runnerPool),
+                groups[id], taskID, context, std::move(notify));
+            bool isIO = (task.resourceClass == Workflow::ResourceClass::IO && ioParallelCount > 0);
+            (isIO ? ioPool : pool).execute(std::move(runner));
+        }
     };
 } // namespace MultiGenerator::Executor
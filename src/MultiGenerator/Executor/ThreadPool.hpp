@@ -14,7 +14,17 @@
 #include <atomic>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <chrono>
+#include <optional>
+#include <algorithm>
+#include <cstdint>
+#include <condition_variable>
 
+#include <time.h>
+#include <pthread.h>
+
+#include <MultiGenerator/Context/Trace.hpp>
 #include <MultiGenerator/Workflow/Runner.hpp>
 #include <MultiGenerator/Executor/Channel.hpp>
 
@@ -26,13 +36,34 @@ namespace MultiGenerator::Executor {
      */
     struct ThreadPoolStatus {
         std::atomic_int runningWorkerCount;
+        std::atomic_int idleWorkerCount;
+        std::atomic_int peakWorkerCount;
+        /** How many runners are in the queue and not taken by a worker yet. */
+        std::atomic_int pendingRunnerCount;
+        /** The workers never retire below this count. */
+        int minWorkerCount;
+        /** How long an idle worker waits before retiring, or zero to never retire. */
+        std::chrono::milliseconds idleTimeout;
         Sender<std::shared_ptr<Workflow::Runner>> runnerSender;
         Receiver<std::shared_ptr<Workflow::Runner>> runnerReceiver;
 
         ThreadPoolStatus() :
             runningWorkerCount(0),
+            idleWorkerCount(0),
+            peakWorkerCount(0),
+            pendingRunnerCount(0),
+            minWorkerCount(0),
+            idleTimeout(0),
             runnerSender(),
             runnerReceiver() {
+            open();
+        }
+
+        /**
+         * @brief Create a new queue. It's used to restart a stopped pool.
+         *
+         */
+        void open() {
             auto channel = Channel<std::shared_ptr<Workflow::Runner>>::create();
             runnerSender = std::move(channel.first);
             runnerReceiver = std::move(channel.second);
@@ -46,32 +77,59 @@ namespace MultiGenerator::Executor {
     class Worker {
     public:
         Worker() :
-            handle() {}
+            handle(),
+            finished(false),
+            busy(false),
+            serial(0),
+            lastSerial(0),
+            lastCpuTime(0) {}
 
         ~Worker() {
             stop();
         }
         
         /**
-         * @brief Initialize a worker thread.
+         * @brief Initialize a worker thread. The worker must have been counted
+         * in runningWorkerCount, and it uncounts itself when quitting.
          *
          * @param status the status of the thread pool
          */
         void start(ThreadPoolStatus &status) {
             handle = std::thread([&, this]() {
-                status.runningWorkerCount.fetch_add(1, std::memory_order_relaxed);
+                if (Context::Trace::isEnabled())
+                    Context::Trace::getInstance().setThreadName("worker");
 
                 while (true) {
-                    /** Get a runner from the queue or quit if it's empty. */
+                    /** Get a runner from the queue or quit if it's closed or timeout. */
+                    status.idleWorkerCount.fetch_add(1, std::memory_order_relaxed);
                     auto runner = getRunner(status);
+                    status.idleWorkerCount.fetch_sub(1, std::memory_order_relaxed);
+
+                    if (runner.has_value()) {
+                        status.pendingRunnerCount.fetch_sub(1, std::memory_order_relaxed);
+                        serial.fetch_add(1, std::memory_order_relaxed);
+                        busy.store(true, std::memory_order_relaxed);
+
+                        if (Context::Trace::isEnabled()) {
+                            Context::Trace::getInstance().record("queue wait", "pool",
+                                runner.value()->getEnqueueTime(), Context::Trace::Clock::now());
+                        }
 
-                    if (runner)
-                        runner->call();
-                    else
+                        runner.value()->call();
+                        busy.store(false, std::memory_order_relaxed);
+                        continue;
+                    }
+
+                    if (!status.runnerReceiver.isOpen()) {
+                        status.runningWorkerCount.fetch_sub(1, std::memory_order_relaxed);
+                        break;
+                    }
+
+                    if (retire(status))
                         break;
                 }
 
-                status.runningWorkerCount.fetch_sub(1, std::memory_order_relaxed);
+                finished.store(true, std::memory_order_release);
             });
         }
 
@@ -84,12 +142,208 @@ namespace MultiGenerator::Executor {
             if (handle.joinable())
                 handle.join();
         }
+
+        /**
+         * @brief Check whether the worker thread has quitted and can be joined
+         * without waiting.
+         *
+         */
+        bool isFinished() const {
+            return finished.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Check whether the worker has been running the same runner since
+         * the last check without using most of the CPU time, which means that
+         * the runner is blocked on I/O or a lock. Only one thread may call it.
+         *
+         * @param interval the time since the last check
+         * @return true if the worker is blocked
+         */
+        bool isBlocked(std::chrono::nanoseconds interval) {
+            auto currentSerial = serial.load(std::memory_order_relaxed);
+            bool isBusy = busy.load(std::memory_order_relaxed);
+            auto cpuTime = getCpuTime();
+            bool res = isBusy && currentSerial == lastSerial && cpuTime >= 0
+                && (cpuTime - lastCpuTime) * 2 < interval.count();
+
+            lastSerial = currentSerial;
+            lastCpuTime = cpuTime;
+            return res;
+        }
+    private:
+        std::thread handle;
+        std::atomic_bool finished;
+        std::atomic_bool busy;
+        /** Increase when starting a new runner. */
+        std::atomic<std::uint64_t> serial;
+        std::uint64_t lastSerial;
+        std::int64_t lastCpuTime;
+
+        std::optional<std::shared_ptr<Workflow::Runner>> getRunner(ThreadPoolStatus &status) {
+            if (status.idleTimeout.count() == 0)
+                return status.runnerReceiver.receive();
+            else
+                return status.runnerReceiver.receiveFor(status.idleTimeout);
+        }
+
+        /**
+         * @brief Quit this worker after being idle for a while, unless the pool
+         * would be smaller than its min count.
+         *
+         * @return true if this worker should quit
+         */
+        static bool retire(ThreadPoolStatus &status) {
+            int count = status.runningWorkerCount.load(std::memory_order_relaxed);
+
+            while (count > status.minWorkerCount) {
+                if (status.runningWorkerCount.compare_exchange_weak(count, count - 1,
+                    std::memory_order_relaxed))
+                    return true;
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief Get the CPU time used by the worker thread.
+         *
+         * @return the time in nanoseconds or -1 if failed
+         */
+        std::int64_t getCpuTime() {
+            clockid_t clock;
+            timespec time;
+
+            if (::pthread_getcpuclockid(handle.native_handle(), &clock) != 0
+                || ::clock_gettime(clock, &time) != 0)
+                return -1;
+
+            return static_cast<std::int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+        }
+    };
+
+    /**
+     * @brief A class which owns the workers of a thread pool. If the pool is
+     * elastic, it checks the workers periodically on a background thread and
+     * adds a worker when runners are waiting while some workers are blocked.
+     *
+     */
+    class WorkerManager {
+    public:
+        static constexpr std::chrono::milliseconds SAMPLE_INTERVAL{ 10 };
+
+        WorkerManager(ThreadPoolStatus &status) :
+            status(status),
+            workers(),
+            maxWorkerCount(0),
+            isScaling(false),
+            handle(),
+            mtx(),
+            cond() {}
+
+        ~WorkerManager() {
+            stop();
+        }
+
+        /**
+         * @brief Start count workers at once.
+         *
+         * @param count the count of workers
+         */
+        void spawn(int count) {
+            std::lock_guard<std::mutex> lock(mtx);
+
+            for (int i = 0; i < count; ++i)
+                spawnWorker();
+        }
+
+        /**
+         * @brief Start checking the workers and adding new ones on the background.
+         *
+         * @param maxWorkerCount the upper bound of the count of workers
+         */
+        void startScaling(int maxWorkerCount) {
+            this->maxWorkerCount = maxWorkerCount;
+            isScaling = true;
+            handle = std::thread([this]() {
+                std::unique_lock<std::mutex> lock(mtx);
+
+                while (!cond.wait_for(lock, SAMPLE_INTERVAL, [this]() { return !isScaling; }))
+                    scale();
+            });
+        }
+
+        /**
+         * @brief Stop checking and wait for all workers to quit. The queue must
+         * have been closed before.
+         *
+         */
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                isScaling = false;
+            }
+
+            cond.notify_all();
+
+            if (handle.joinable())
+                handle.join();
+
+            for (auto &worker : workers)
+                worker->stop();
+
+            workers.clear();
+        }
     private:
+        ThreadPoolStatus &status;
+        std::vector<std::unique_ptr<Worker>> workers;
+        int maxWorkerCount;
+        bool isScaling;
         std::thread handle;
+        std::mutex mtx;
+        std::condition_variable cond;
+
+        void spawnWorker() {
+            int count = status.runningWorkerCount.fetch_add(1, std::memory_order_relaxed) + 1;
+            int peak = status.peakWorkerCount.load(std::memory_order_relaxed);
+
+            while (peak < count && !status.peakWorkerCount.compare_exchange_weak(peak, count,
+                std::memory_order_relaxed)) {}
 
-        std::shared_ptr<Workflow::Runner> getRunner(ThreadPoolStatus &status) {
-            auto runner = status.runnerReceiver.receive();
-            return runner.value_or(std::shared_ptr<Workflow::Runner>());
+            workers.push_back(std::make_unique<Worker>());
+            workers.back()->start(status);
+        }
+
+        /**
+         * @brief Keep about minWorkerCount workers using the CPU by replacing the
+         * blocked ones while there are runners waiting.
+         *
+         */
+        void scale() {
+            /** Join the retired workers. */
+            for (auto it = workers.begin(); it != workers.end();) {
+                if ((*it)->isFinished()) {
+                    (*it)->stop();
+                    it = workers.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+
+            int blockedCount = 0;
+
+            for (auto &worker : workers) {
+                if (worker->isBlocked(SAMPLE_INTERVAL))
+                    ++blockedCount;
+            }
+
+            int pendingCount = status.pendingRunnerCount.load(std::memory_order_relaxed);
+            int workerCount = status.runningWorkerCount.load(std::memory_order_relaxed);
+            int count = std::min({ status.minWorkerCount - (workerCount - blockedCount),
+                pendingCount, maxWorkerCount - workerCount });
+
+            for (int i = 0; i < count; ++i)
+                spawnWorker();
         }
     };
 
@@ -100,6 +354,14 @@ namespace MultiGenerator::Executor {
         }
     };
 
+    class WorkerCountRangeInvalidException : public std::exception {
+    public:
+        const char *what() const noexcept override {
+            return "WorkerCountRangeInvalidException: "
+                "The max count of threads must not be less than the min count.";
+        }
+    };
+
     class ThreadPoolAlreadyStartedException : public std::exception {
     public:
         const char *what() const noexcept override {
@@ -130,7 +392,10 @@ namespace MultiGenerator::Executor {
     };
 
     /**
-     * @brief A class which manages the workers and posts runners.
+     * @brief A class which manages the workers and posts runners. The pool can
+     * be elastic: it starts with the min count of workers, adds workers when
+     * the runners in the queue are waiting for blocked workers, and retires the
+     * workers idle for a while, staying between the min and max counts.
      *
      */
     class ThreadPool {
@@ -144,7 +409,7 @@ namespace MultiGenerator::Executor {
             maxWorkerCount(0),
             isStopped(true),
             status(std::make_unique<ThreadPoolStatus>()),
-            workers() {}
+            manager(std::make_unique<WorkerManager>(*status)) {}
 
         /**
          * @brief Construct a new thread pool object with maxWorkerCount worker(s)
@@ -153,10 +418,7 @@ namespace MultiGenerator::Executor {
          * @param maxWorkerCount haw many worker(s) to create
          */
         ThreadPool(int maxWorkerCount) :
-            maxWorkerCount(0),
-            isStopped(true),
-            status(std::make_unique<ThreadPoolStatus>()),
-            workers() {
+            ThreadPool() {
             start(maxWorkerCount);
         }
 
@@ -181,21 +443,39 @@ namespace MultiGenerator::Executor {
          * @param maxWorkerCount haw many worker(s) to create
          */
         void start(int maxWorkerCount) {
-            if (maxWorkerCount <= 0)
+            start(maxWorkerCount, maxWorkerCount, std::chrono::milliseconds(0));
+        }
+
+        /**
+         * @brief Start an elastic thread pool with minWorkerCount worker(s). At most
+         * maxWorkerCount worker(s) run at the same time, and the ones beyond
+         * minWorkerCount quit after being idle for idleTimeout. Throw exception
+         * when the counts are invalid or the pool has already started.
+         *
+         * @param minWorkerCount how many worker(s) to create and keep
+         * @param maxWorkerCount how many worker(s) can run at most
+         * @param idleTimeout how long an extra worker waits before quitting
+         */
+        void start(int minWorkerCount, int maxWorkerCount, std::chrono::milliseconds idleTimeout) {
+            if (minWorkerCount <= 0)
                 throw MaxThreadCountInvalidException();
 
+            if (maxWorkerCount < minWorkerCount)
+                throw WorkerCountRangeInvalidException();
+
             if (!isStopped)
                 throw ThreadPoolAlreadyStartedException();
 
+            status->minWorkerCount = minWorkerCount;
+            /** A fixed pool never retires its workers. */
+            status->idleTimeout = (maxWorkerCount > minWorkerCount
+                ? std::max(idleTimeout, std::chrono::milliseconds(1)) : std::chrono::milliseconds(0));
+            status->peakWorkerCount = 0;
             setMaxWorkerCount(maxWorkerCount);
-            workers = std::vector<Worker>(static_cast<std::size_t>(maxWorkerCount));
-
-            for (auto &worker : workers)
-                worker.start(*status);
+            manager->spawn(minWorkerCount);
 
-            /** Return before all workers finish initializing. */
-            while (status->runningWorkerCount != maxWorkerCount)
-                std::this_thread::sleep_for(std::chrono::nanoseconds(100));
+            if (maxWorkerCount > minWorkerCount)
+                manager->startScaling(maxWorkerCount);
         }
 
         /**
@@ -207,14 +487,38 @@ namespace MultiGenerator::Executor {
             if (isStopped)
                 throw ThreadPoolAlreadyStoppedException();
 
-            for (int i = 0; i < maxWorkerCount; ++i)
-                status->runnerSender.send(std::shared_ptr<Workflow::Runner>());
-
+            /** Close the queue, and the workers quit after it becomes empty. */
+            status->runnerSender.reset();
             setMaxWorkerCount(0);
-
             /** Ensure that all workers stop first. */
-            for (auto &worker : workers)
-                worker.stop();
+            manager->stop();
+            /** Prepare a new queue for the next start(). */
+            status->open();
+        }
+
+        /**
+         * @brief Get how many workers are running now.
+         *
+         */
+        int getWorkerCount() const {
+            return status->runningWorkerCount.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the max count of workers running at the same time since
+         * the pool started.
+         *
+         */
+        int getPeakWorkerCount() const {
+            return status->peakWorkerCount.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get how many workers are waiting for runners now.
+         *
+         */
+        int getIdleWorkerCount() const {
+            return status->idleWorkerCount.load(std::memory_order_relaxed);
         }
 
         /**
@@ -249,13 +553,17 @@ namespace MultiGenerator::Executor {
             if (!runner)
                 throw RunnerHandleInvalidException();
 
+            if (Context::Trace::isEnabled())
+                runner->setEnqueueTime(Context::Trace::Clock::now());
+
+            status->pendingRunnerCount.fetch_add(1, std::memory_order_relaxed);
             status->runnerSender.send(std::move(runner));
         }
     private:
         int maxWorkerCount;
         bool isStopped;
         std::unique_ptr<ThreadPoolStatus> status;
-        std::vector<Worker> workers;
+        std::unique_ptr<WorkerManager> manager;
 
         void setMaxWorkerCount(int count) {
             maxWorkerCount = count;
@@ -0,0 +1,177 @@
+/**
+ * @file MultiGenerator/Executor/Watchdog.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief A thread which fires callbacks when tasks run out of their time.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#include <MultiGenerator/Workflow/Function.hpp>
+
+namespace MultiGenerator::Executor {
+    class TaskTimeoutException : public std::exception {
+    public:
+        TaskTimeoutException(std::chrono::milliseconds timeLimit) :
+            msg("TaskTimeoutException: The task ran longer than "
+                + std::to_string(timeLimit.count()) + " ms.") {}
+
+        const char *what() const noexcept override {
+            return msg.c_str();
+        }
+    private:
+        std::string msg;
+    };
+
+    /**
+     * @brief A thread which keeps the deadlines of the running tasks and calls
+     * the callback of a task when its deadline passes. A callback is called
+     * with the lock held, so once unwatch() returns, it won't be called any more.
+     * Keep the callbacks short.
+     *
+     */
+    class Watchdog {
+    public:
+        using Handle = long long;
+
+        Watchdog() :
+            entries(),
+            nextHandle(0),
+            isStopped(true),
+            mtx(),
+            cond(),
+            thread() {}
+
+        Watchdog(const Watchdog &) = delete;
+
+        Watchdog &operator=(const Watchdog &) = delete;
+
+        ~Watchdog() {
+            stop();
+        }
+
+        void start() {
+            std::lock_guard<std::mutex> lock(mtx);
+
+            if (!isStopped)
+                return;
+
+            isStopped = false;
+            thread = std::thread([this]() {
+                patrol();
+            });
+        }
+
+        /**
+         * @brief Stop the thread. The callbacks which haven't been called are dropped.
+         *
+         */
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+
+                if (isStopped)
+                    return;
+
+                isStopped = true;
+                entries.clear();
+            }
+
+            cond.notify_all();
+            thread.join();
+        }
+
+        /**
+         * @brief Call expire after timeLimit unless unwatch() is called before.
+         *
+         * @param timeLimit the time from now
+         * @param expire the callback
+         * @return the handle which is passed to unwatch()
+         */
+        Handle watch(std::chrono::steady_clock::duration timeLimit, Workflow::SmallFunction<void()> expire) {
+            Handle handle;
+
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                handle = nextHandle++;
+                entries.push_back(Entry{ handle, std::chrono::steady_clock::now() + timeLimit, std::move(expire) });
+            }
+
+            cond.notify_one();
+            return handle;
+        }
+
+        void unwatch(Handle handle) {
+            std::lock_guard<std::mutex> lock(mtx);
+
+            for (std::size_t i = 0; i < entries.size(); ++i) {
+                if (entries[i].handle == handle) {
+                    remove(i);
+                    return;
+                }
+            }
+        }
+    private:
+        struct Entry {
+            Handle handle;
+            std::chrono::steady_clock::time_point deadline;
+            Workflow::SmallFunction<void()> expire;
+        };
+
+        /**
+         * Only the running tasks are watched, so a linear scan is cheap enough.
+         * The vector keeps its capacity, so watching a task allocates nothing
+         * once as many tasks as the workers have been watched.
+         */
+        std::vector<Entry> entries;
+        Handle nextHandle;
+        bool isStopped;
+        std::mutex mtx;
+        std::condition_variable cond;
+        std::thread thread;
+
+        void patrol() {
+            std::unique_lock<std::mutex> lock(mtx);
+
+            while (!isStopped) {
+                auto now = std::chrono::steady_clock::now();
+                auto earliest = std::chrono::steady_clock::time_point::max();
+
+                for (std::size_t i = 0; i < entries.size();) {
+                    if (entries[i].deadline <= now) {
+                        entries[i].expire();
+                        remove(i);
+                    } else {
+                        earliest = std::min(earliest, entries[i].deadline);
+                        ++i;
+                    }
+                }
+
+                if (earliest == std::chrono::steady_clock::time_point::max())
+                    cond.wait(lock);
+                else
+                    cond.wait_until(lock, earliest);
+            }
+        }
+
+        /** The order of the entries doesn't matter, so move the last one into the hole. */
+        void remove(std::size_t index) {
+            if (index + 1 != entries.size())
+                entries[index] = std::move(entries.back());
+
+            entries.pop_back();
+        }
+    };
+} // namespace MultiGenerator::Executor
@@ -0,0 +1,402 @@
+/**
+ * @file MultiGenerator/Interface/Calibration.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief The calibration which measures the standard solution repeatedly to
+ * help setting the time limit of a problem.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <exception>
+#include <stdexcept>
+#include <system_error>
+#include <map>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <optional>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include <filesystem>
+
+#include <time.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include <MultiGenerator/Variable/Argument.hpp>
+#include <MultiGenerator/Executor/Failure.hpp>
+#include <MultiGenerator/Interface/Component.hpp>
+
+namespace MultiGenerator::Interface {
+    class CalibrationBoundInvalidException : public std::exception {
+    public:
+        CalibrationBoundInvalidException(const std::string &testcase, const std::string &key,
+            const std::string &value) :
+            msg("CalibrationBoundInvalidException: The bound " + key + " of test case "
+                + testcase + " isn't a number: " + value) {}
+
+        const char *what() const noexcept override {
+            return msg.c_str();
+        }
+    private:
+        std::string msg;
+    };
+
+    /**
+     * @brief Whether the input file is in the page cache when the solution runs.
+     *
+     */
+    enum class CacheMode {
+        /** The file is read once before the runs. */
+        Warm,
+        /** The file is dropped from the page cache before every run. */
+        Cold
+    };
+
+    /**
+     * @brief The distribution of some measured times in seconds.
+     *
+     */
+    struct TimeStatistics {
+        double min = 0;
+        double median = 0;
+        double p99 = 0;
+
+        static TimeStatistics create(std::vector<double> times) {
+            TimeStatistics res;
+
+            if (times.empty())
+                return res;
+
+            std::sort(times.begin(), times.end());
+            auto size = times.size();
+            res.min = times.front();
+            res.median = (size % 2 == 1 ? times[size / 2] : (times[size / 2 - 1] + times[size / 2]) / 2);
+            /** The nearest-rank percentile. */
+            auto rank = static_cast<std::size_t>(std::ceil(0.99 * static_cast<double>(size)));
+            res.p99 = times[std::max<std::size_t>(rank, 1) - 1];
+            return res;
+        }
+    };
+
+    /**
+     * @brief The measured times of one test case in one cache mode.
+     *
+     */
+    struct CalibrationResult {
+        std::string testcase;
+        /** The subtask ID, or -1 if the test case has no subtask. */
+        int subtask = -1;
+        CacheMode cacheMode = CacheMode::Warm;
+        std::vector<double> wallTimes;
+        std::vector<double> cpuTimes;
+        TimeStatistics wallTime;
+        TimeStatistics cpuTime;
+        /** Whether the median wall time is outside the target band in the config. */
+        bool isOutOfBand = false;
+        /** Why a run threw, or empty. A failed result has no statistics and isn't summarized. */
+        std::string reason;
+    };
+
+    /**
+     * @brief The measured times of all test cases of a subtask in one cache mode.
+     *
+     */
+    struct SubtaskCalibration {
+        int subtask;
+        CacheMode cacheMode;
+        TimeStatistics wallTime;
+        TimeStatistics cpuTime;
+    };
+
+    struct CalibrationConfig {
+        /** How many times the solution runs on a test case in each cache mode. */
+        int runCount = 5;
+        std::vector<CacheMode> cacheModes = { CacheMode::Warm, CacheMode::Cold };
+        /** How many test cases are measured at the same time. */
+        int threadCount = 1;
+        /** Whether every measuring thread is pinned to its own core. */
+        bool isPinned = true;
+        /** The keys in DataConfig of the lower and upper bounds of the median time in seconds. */
+        std::string lowerBoundKey = "timeLowerBound";
+        std::string upperBoundKey = "timeUpperBound";
+    };
+
+    class CalibrationReport {
+    public:
+        CalibrationReport(std::vector<CalibrationResult> results) :
+            results(std::move(results)),
+            subtasks() {
+            summarize();
+        }
+
+        ~CalibrationReport() {}
+
+        const std::vector<CalibrationResult> &getResults() const {
+            return results;
+        }
+
+        const std::vector<SubtaskCalibration> &getSubtasks() const {
+            return subtasks;
+        }
+
+        /**
+         * @brief Get the results whose median time is outside the target band.
+         *
+         */
+        std::vector<CalibrationResult> getOutOfBand() const {
+            std::vector<CalibrationResult> res;
+            std::copy_if(results.begin(), results.end(), std::back_inserter(res), [](const auto &result) {
+                return result.isOutOfBand;
+            });
+            return res;
+        }
+
+        /**
+         * @brief Get the results whose runs threw.
+         *
+         */
+        std::vector<CalibrationResult> getFailed() const {
+            std::vector<CalibrationResult> res;
+            std::copy_if(results.begin(), results.end(), std::back_inserter(res), [](const auto &result) {
+                return !result.reason.empty();
+            });
+            return res;
+        }
+    private:
+        std::vector<CalibrationResult> results;
+        std::vector<SubtaskCalibration> subtasks;
+
+        void summarize() {
+            std::map<std::pair<int, CacheMode>, std::pair<std::vector<double>, std::vector<double>>> times;
+
+            for (const auto &result : results) {
+                if (result.subtask < 0 || !result.reason.empty())
+                    continue;
+
+                auto &[wallTimes, cpuTimes] = times[{ result.subtask, result.cacheMode }];
+                wallTimes.insert(wallTimes.end(), result.wallTimes.begin(), result.wallTimes.end());
+                cpuTimes.insert(cpuTimes.end(), result.cpuTimes.begin(), result.cpuTimes.end());
+            }
+
+            for (const auto &[key, value] : times) {
+                subtasks.push_back({ key.first, key.second, TimeStatistics::create(value.first),
+                    TimeStatistics::create(value.second) });
+            }
+        }
+    };
+
+    /**
+     * @brief A runner of the calibration. It reruns the solution of every test
+     * case on the input generated before and measures every run. An external
+     * solution is measured by its process, and the others by the CPU time of
+     * the measuring thread. A run which throws fails its result, and the other
+     * test cases are still measured.
+     *
+     */
+    class Calibrator {
+    public:
+        using Constructor = std::function<std::unique_ptr<SolutionTask>()>;
+
+        Calibrator(const CalibrationConfig &config) :
+            config(config),
+            testcases() {}
+
+        ~Calibrator() {}
+
+        /**
+         * @brief Add a test case.
+         *
+         * @param arg the argument of the test case
+         * @param constructor the function creating the solution, which mustn't
+         * write the standard answer
+         * @param inputFile the input file read by the solution
+         * @param outputFile the output file written by the solution, which is
+         * removed after the calibration
+         */
+        void add(std::shared_ptr<Variable::Argument> arg, Constructor constructor,
+            const std::string &inputFile, const std::string &outputFile) {
+            /** Check the bounds here, so that a malformed one throws before any run. */
+            auto lowerBound = getBound(*arg, config.lowerBoundKey);
+            auto upperBound = getBound(*arg, config.upperBoundKey);
+            testcases.push_back({ std::move(arg), std::move(constructor), inputFile, outputFile,
+                lowerBound, upperBound });
+        }
+
+        CalibrationReport run() {
+            std::vector<CalibrationResult> results(testcases.size() * config.cacheModes.size());
+            std::atomic_size_t next(0);
+            auto cores = getAllowedCores();
+            std::vector<std::thread> threads;
+
+            for (int i = 0; i < std::max(config.threadCount, 1); ++i) {
+                threads.emplace_back([&, i]() {
+                    if (config.isPinned && !cores.empty())
+                        pin(cores[static_cast<std::size_t>(i) % cores.size()]);
+
+                    for (std::size_t index; (index = next++) < testcases.size();) {
+                        for (std::size_t j = 0; j < config.cacheModes.size(); ++j)
+                            results[index * config.cacheModes.size() + j] = measure(testcases[index], config.cacheModes[j]);
+
+                        std::error_code error;
+                        std::filesystem::remove(std::filesystem::path(testcases[index].outputFile), error);
+                    }
+                });
+            }
+
+            for (auto &thread : threads)
+                thread.join();
+
+            return CalibrationReport(std::move(results));
+        }
+    private:
+        struct Testcase {
+            std::shared_ptr<Variable::Argument> arg;
+            Constructor constructor;
+            std::string inputFile;
+            std::string outputFile;
+            std::optional<double> lowerBound;
+            std::optional<double> upperBound;
+        };
+
+        CalibrationConfig config;
+        std::vector<Testcase> testcases;
+
+        CalibrationResult measure(const Testcase &testcase, CacheMode cacheMode) {
+            CalibrationResult res;
+            res.testcase = testcase.arg->getID();
+            auto subtask = std::dynamic_pointer_cast<Variable::SubtaskArgument>(testcase.arg);
+            res.subtask = (subtask ? subtask->getSubtask() : -1);
+            res.cacheMode = cacheMode;
+
+            if (cacheMode == CacheMode::Warm)
+                prepareCache(testcase.inputFile, false);
+
+            try {
+                for (int i = 0; i < config.runCount; ++i) {
+                    if (cacheMode == CacheMode::Cold)
+                        prepareCache(testcase.inputFile, true);
+
+                    /** Every run parses its input again. */
+                    testcase.arg->releaseSharedInputs();
+                    auto task = testcase.constructor();
+                    task->setArgument(testcase.arg);
+
+                    auto cpuStart = getThreadCpuTime();
+                    auto wallStart = std::chrono::steady_clock::now();
+                    task->call();
+                    double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+                    double cpuTime = getThreadCpuTime() - cpuStart;
+
+                    if (auto process = dynamic_cast<ProcessSolutionTask *>(task.get())) {
+                        wallTime = process->getResult().wallTime;
+                        cpuTime = process->getResult().cpuTime;
+                    }
+
+                    res.wallTimes.push_back(wallTime);
+                    res.cpuTimes.push_back(cpuTime);
+                }
+            } catch (...) {
+                /** An exception mustn't escape the measuring thread. */
+                res.reason = Executor::FailureCollector::describe(std::current_exception());
+                return res;
+            }
+
+            res.wallTime = TimeStatistics::create(res.wallTimes);
+            res.cpuTime = TimeStatistics::create(res.cpuTimes);
+            double median = res.wallTime.median;
+            res.isOutOfBand = (testcase.lowerBound.has_value() && median < testcase.lowerBound.value())
+                || (testcase.upperBound.has_value() && median > testcase.upperBound.value());
+            return res;
+        }
+
+        /**
+         * @brief Parse a bound of the median time. Throw if it isn't a number.
+         *
+         */
+        static std::optional<double> getBound(const Variable::Argument &arg, const std::string &key) {
+            auto value = arg.getConfig().get(key);
+
+            if (!value.has_value())
+                return std::nullopt;
+
+            try {
+                std::size_t size = 0;
+                double res = std::stod(value.value(), &size);
+
+                if (size == value.value().size() && std::isfinite(res))
+                    return res;
+            } catch (const std::logic_error &) {}
+
+            throw CalibrationBoundInvalidException(arg.getID(), key, value.value());
+        }
+
+        /**
+         * @brief Load the file into the page cache, or drop it from the cache.
+         *
+         */
+        static void prepareCache(const std::string &fileName, bool isDropped) {
+            int fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+
+            if (fd < 0)
+                return;
+
+            if (isDropped) {
+                /** Only clean pages can be dropped. */
+                ::fdatasync(fd);
+                ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            } else {
+                char buffer[1 << 16];
+
+                while (::read(fd, buffer, sizeof(buffer)) > 0) {}
+            }
+
+            ::close(fd);
+        }
+
+        static double getThreadCpuTime() {
+            timespec time{};
+            ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+            return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) / 1e9;
+        }
+
+        static std::vector<int> getAllowedCores() {
+            std::vector<int> res;
+            cpu_set_t set;
+            CPU_ZERO(&set);
+
+            if (::sched_getaffinity(0, sizeof(set), &set) != 0)
+                return res;
+
+            for (int i = 0; i < CPU_SETSIZE; ++i) {
+                if (CPU_ISSET(i, &set))
+                    res.push_back(i);
+            }
+
+            return res;
+        }
+
+        /**
+         * @brief Pin the current thread to a core. An external solution started
+         * by the thread inherits it.
+         *
+         */
+        static void pin(int core) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(core, &set);
+            ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+        }
+    };
+} // namespace MultiGenerator::Interface
@@ -11,12 +11,33 @@
 #pragma once
 
 #include <string>
+#include <memory>
+#include <type_traits>
+#include <exception>
 
 #include <MultiGenerator/Variable/Argument.hpp>
 #include <MultiGenerator/Workflow/Task.hpp>
 #include <MultiGenerator/Context/Environment.hpp>
+#include <MultiGenerator/Context/Pipe.hpp>
+#include <MultiGenerator/Context/Process.hpp>
+#include <MultiGenerator/Context/Trace.hpp>
+#include <MultiGenerator/Context/Memory.hpp>
+#include <MultiGenerator/Interface/Report.hpp>
 
 namespace MultiGenerator::Interface {
+    class InputNotGeneratedException : public std::exception {
+    public:
+        InputNotGeneratedException(const std::string &id) :
+            msg("InputNotGeneratedException: The input object of test case " + id
+                + " isn't generated before it's written.") {}
+
+        const char *what() const noexcept override {
+            return msg.c_str();
+        }
+    private:
+        std::string msg;
+    };
+
     /**
      * @brief A task class for executing a generator program.
      * 
@@ -26,6 +47,7 @@ namespace MultiGenerator::Interface {
         GeneratingTask() :
             Workflow::Task(),
             problemName(),
+            pipe(),
             inputFile() {}
 
         ~GeneratingTask() {}
@@ -34,13 +56,36 @@ namespace MultiGenerator::Interface {
             this->problemName = problemName;
         }
 
+        /**
+         * @brief Copy the input data to a pipe while writing it to the file, so that
+         * a validator can read it at the same time. Call it before setArgument().
+         *
+         * @param pipe the pipe read by the validator
+         */
+        void setPipe(std::shared_ptr<Context::Pipe> pipe) {
+            this->pipe = std::move(pipe);
+        }
+
         void setArgument(std::shared_ptr<Variable::Argument> arg) override {
             Workflow::Task::setArgument(std::move(arg));
             initEnvironment();
         }
 
         void call() override {
-            generate(inputFile->getOutputStream(), arg->getConfig());
+            MULTIGENERATOR_TRACE_SCOPE(scope, "generate", "task");
+            MULTIGENERATOR_TRACE_ARGUMENT(scope, "testcase", arg->getID());
+            MULTIGENERATOR_MEMORY_SCOPE(memory, arg->getID(), "generate");
+
+            try {
+                generate(inputFile->getOutputStream(), arg->getConfig());
+                /** Flush now since the next task may start before this one is destroyed. */
+                inputFile->getOutputStream().flush();
+            } catch (...) {
+                closePipe();
+                throw;
+            }
+
+            closePipe();
         }
     protected:
         /**
@@ -53,14 +98,30 @@ namespace MultiGenerator::Interface {
         virtual void generate(std::ostream &data, const Variable::DataConfig &config) = 0;
     private:
         std::string problemName;
+        std::shared_ptr<Context::Pipe> pipe;
         std::unique_ptr<Context::Environment> inputFile;
 
         void initEnvironment() {
+            auto fileName = problemName + arg->getID() + ".in";
+            std::unique_ptr<Context::OutputStream> os = std::make_unique<Context::FileOutputStream>(fileName);
+
+            if (pipe) {
+                /** The validator may not start before the pipe fills, e.g. with one worker. */
+                pipe->setSpillFile(fileName);
+                os = std::make_unique<Context::TeeOutputStream>(std::move(os),
+                    std::make_unique<Context::PipeOutputStream>(pipe));
+            }
+
             inputFile = std::make_unique<Context::Environment>(
                 std::unique_ptr<Context::InputStream>(),
-                std::make_unique<Context::FileOutputStream>(problemName + arg->getID() + ".in")
+                std::move(os)
             );
         }
+
+        void closePipe() {
+            if (pipe)
+                pipe->closeWrite();
+        }
     };
 
     /**
@@ -72,7 +133,9 @@ namespace MultiGenerator::Interface {
         SolutionTask() :
             Workflow::Task(),
             problemName(),
-            file() {}
+            outputExtension(".out"),
+            file(),
+            isFileEnvironment(true) {}
 
         ~SolutionTask() {}
 
@@ -80,13 +143,39 @@ namespace MultiGenerator::Interface {
             this->problemName = problemName;
         }
 
+        /**
+         * @brief Change the extension of the output file, which is ".out" by
+         * default. Call it before setArgument().
+         *
+         * @param outputExtension the extension including the leading dot
+         */
+        void setOutputExtension(const std::string &outputExtension) {
+            this->outputExtension = outputExtension;
+        }
+
         void setArgument(std::shared_ptr<Variable::Argument> arg) override {
             Workflow::Task::setArgument(std::move(arg));
             initEnvironment();
         }
 
+        /**
+         * @brief Replace the files of the test case with other streams, e.g.
+         * streams in memory. Call it after setArgument().
+         *
+         * @param file the environment providing both streams
+         */
+        void setEnvironment(std::unique_ptr<Context::Environment> file) {
+            this->file = std::move(file);
+            isFileEnvironment = false;
+        }
+
         void call() override {
+            MULTIGENERATOR_TRACE_SCOPE(scope, "solve", "task");
+            MULTIGENERATOR_TRACE_ARGUMENT(scope, "testcase", arg->getID());
+            MULTIGENERATOR_MEMORY_SCOPE(memory, arg->getID(), "solve");
+
             solve(file->getInputStream(), file->getOutputStream(), arg->getConfig());
+            file->getOutputStream().flush();
         }
     protected:
         /**
@@ -100,15 +189,345 @@ namespace MultiGenerator::Interface {
          */
         virtual void solve(std::istream &dataIn, std::ostream &dataOut,
             const Variable::DataConfig &config) = 0;
+
+        /**
+         * @brief Check whether the task reads and writes the files of the test
+         * case, i.e. setEnvironment() is never called.
+         * 
+         */
+        bool hasFileEnvironment() const {
+            return isFileEnvironment;
+        }
+
+        std::string getInputFileName() const {
+            return problemName + arg->getID() + ".in";
+        }
+
+        std::string getOutputFileName() const {
+            return problemName + arg->getID() + outputExtension;
+        }
+
+        /**
+         * @brief Check whether solve() reads the input file. The file isn't
+         * opened if it doesn't, since it may be still being written.
+         * 
+         */
+        virtual bool isInputFileRead() const {
+            return true;
+        }
     private:
         std::string problemName;
+        std::string outputExtension;
         std::unique_ptr<Context::Environment> file;
+        bool isFileEnvironment;
 
         void initEnvironment() {
+            std::unique_ptr<Context::InputStream> is;
+
+            if (isInputFileRead())
+                is = std::make_unique<Context::FileInputStream>(getInputFileName());
+            else
+                is = std::make_unique<Context::StringInputStream>(std::string());
+
             file = std::make_unique<Context::Environment>(
-                std::make_unique<Context::FileInputStream>(problemName + arg->getID() + ".in"),
-                std::make_unique<Context::FileOutputStream>(problemName + arg->getID() + ".out")
+                std::move(is),
+                std::make_unique<Context::FileOutputStream>(getOutputFileName())
             );
+            isFileEnvironment = true;
+        }
+    };
+
+    /**
+     * @brief A generator which receives the parameters converted by the schema
+     * of Parameters instead of the config.
+     * 
+     * @tparam Parameters the struct of parameters with a schema
+     */
+    template <typename Parameters>
+    class TypedGeneratingTask : public GeneratingTask {
+    public:
+        using ParameterType = Parameters;
+    protected:
+        /**
+         * @brief Generate data with the typed parameters of the test case.
+         * 
+         * @param data the stream of the file of the input data
+         * @param parameters the parameters of the test case
+         */
+        virtual void generate(std::ostream &data, const Parameters &parameters) = 0;
+    private:
+        void generate(std::ostream &data, const Variable::DataConfig &) final {
+            generate(data, arg->getParameters<Parameters>());
+        }
+    };
+
+    /**
+     * @brief A solution which receives the parameters converted by the schema
+     * of Parameters instead of the config.
+     * 
+     * @tparam Parameters the struct of parameters with a schema
+     */
+    template <typename Parameters>
+    class TypedSolutionTask : public SolutionTask {
+    public:
+        using ParameterType = Parameters;
+    protected:
+        /**
+         * @brief Solve the test case with its typed parameters.
+         * 
+         * @param dataIn the stream of the file of the input data
+         * @param dataOut the stream of the file of the standard answer
+         * @param parameters the parameters of the test case
+         */
+        virtual void solve(std::istream &dataIn, std::ostream &dataOut, const Parameters &parameters) = 0;
+    private:
+        void solve(std::istream &dataIn, std::ostream &dataOut, const Variable::DataConfig &) final {
+            solve(dataIn, dataOut, arg->getParameters<Parameters>());
+        }
+    };
+
+    /**
+     * @brief A solution which receives the input data parsed once for all
+     * solutions of the test case, e.g. the candidates of CheckingTemplate.
+     * Input declares how it's parsed by a static function, e.g.
+     *
+     *     struct Graph {
+     *         std::vector<std::vector<std::pair<int, int>>> edges;
+     *
+     *         static Graph parse(std::istream &dataIn);
+     *     };
+     *
+     * The parsed input is immutable and freed after all tasks of the test case
+     * have finished. If an ObjectGeneratingTask of Input has generated it, the
+     * input file isn't read at all. A solution with another environment, e.g.
+     * in Minimizer, parses its own input.
+     * 
+     * @tparam Input the type of the parsed input
+     */
+    template <typename Input>
+    class ParsedSolutionTask : public SolutionTask {
+    public:
+        using InputType = Input;
+
+        ParsedSolutionTask() :
+            SolutionTask(),
+            input() {}
+
+        void setArgument(std::shared_ptr<Variable::Argument> arg) override {
+            input = arg->template findSharedInput<Input>();
+            SolutionTask::setArgument(std::move(arg));
+        }
+    protected:
+        /**
+         * @brief Solve the test case with the parsed input.
+         * 
+         * @param input the parsed input data
+         * @param dataOut the stream of the file of the standard answer
+         * @param config the specific configures for the solution
+         */
+        virtual void solve(const Input &input, std::ostream &dataOut, const Variable::DataConfig &config) = 0;
+
+        bool isInputFileRead() const override {
+            return !input;
+        }
+    private:
+        /** The input generated before the task is created, if any. */
+        std::shared_ptr<const Input> input;
+
+        void solve(std::istream &dataIn, std::ostream &dataOut, const Variable::DataConfig &config) final {
+            if (!hasFileEnvironment()) {
+                solve(Input::parse(dataIn), dataOut, config);
+                return;
+            }
+
+            if (!input) {
+                input = arg->getSharedInput<Input>([&dataIn]() {
+                    return Input::parse(dataIn);
+                });
+            }
+
+            solve(*input, dataOut, config);
+        }
+    };
+
+    /**
+     * @brief A generator which returns the input data as an object instead of
+     * writing it. A ParsedSolutionTask of Input in the same test case receives
+     * the object directly, while an InputWritingTask writes the input file at
+     * the same time. Besides parse(), Input declares how it's written by a
+     * static function, e.g.
+     *
+     *     static void serialize(std::ostream &data, const Graph &graph);
+     *
+     * @tparam Input the type of the input data
+     */
+    template <typename Input>
+    class ObjectGeneratingTask : public Workflow::Task {
+    public:
+        using InputType = Input;
+
+        ObjectGeneratingTask() :
+            Workflow::Task() {}
+
+        void call() override {
+            MULTIGENERATOR_TRACE_SCOPE(scope, "generate", "task");
+            MULTIGENERATOR_TRACE_ARGUMENT(scope, "testcase", arg->getID());
+            MULTIGENERATOR_MEMORY_SCOPE(memory, arg->getID(), "generate");
+
+            arg->getSharedInput<Input>([this]() {
+                return generate(arg->getConfig());
+            });
+        }
+    protected:
+        /**
+         * @brief Generate the input data of one test case.
+         * 
+         * @param config the specific configures for the generator
+         * @return the input data
+         */
+        virtual Input generate(const Variable::DataConfig &config) = 0;
+    };
+
+    /**
+     * @brief A task which writes the input object generated by an
+     * ObjectGeneratingTask to the input file by Input::serialize().
+     * 
+     * @tparam Input the type of the input data
+     */
+    template <typename Input>
+    class InputWritingTask : public Workflow::Task {
+    public:
+        InputWritingTask() :
+            Workflow::Task(),
+            problemName() {}
+
+        void setProblemName(const std::string &problemName) {
+            this->problemName = problemName;
+        }
+
+        void call() override {
+            MULTIGENERATOR_TRACE_SCOPE(scope, "serialize", "task");
+            MULTIGENERATOR_TRACE_ARGUMENT(scope, "testcase", arg->getID());
+
+            auto input = arg->template findSharedInput<Input>();
+
+            if (!input)
+                throw InputNotGeneratedException(arg->getID());
+
+            Context::FileOutputStream file(problemName + arg->getID() + ".in");
+            Input::serialize(file.getStream(), *input);
+            file.getStream().flush();
+        }
+    private:
+        std::string problemName;
+    };
+
+    template <typename Type, typename = void>
+    struct IsObjectGenerating : std::false_type {};
+
+    template <typename Type>
+    struct IsObjectGenerating<Type, std::void_t<typename Type::InputType>> :
+        std::is_base_of<ObjectGeneratingTask<typename Type::InputType>, Type> {};
+
+    template <typename Type, typename = void>
+    struct HasParameters : std::false_type {};
+
+    template <typename Type>
+    struct HasParameters<Type, std::void_t<typename Type::ParameterType>> : std::true_type {};
+
+    /**
+     * @brief Convert the config of a test case to the parameters of every typed
+     * task in Types, so that a wrong config fails before the execution. Other
+     * types, including void, are skipped.
+     * 
+     * @tparam Types the types of the tasks
+     * @param arg the argument of the test case
+     */
+    template <typename ...Types>
+    void prepareParameters(Variable::Argument &arg) {
+        ([&arg]() {
+            if constexpr (HasParameters<Types>::value)
+                arg.prepareParameters<typename Types::ParameterType>();
+        }(), ...);
+    }
+
+    /**
+     * @brief The result of running an external solution on a test case.
+     * 
+     */
+    struct ProcessRecord {
+        std::string testcase;
+        Context::ProcessResult result;
+    };
+
+    /**
+     * @brief A task class for executing a standalone solution program in a child
+     * process. Its stdin and stdout are connected to the files of the test case
+     * directly, or to the streams set by setEnvironment() through pipes. The
+     * worker waits for the process, so the processes running at the same time
+     * never outnumber the workers of the pool.
+     * 
+     */
+    class ProcessSolutionTask : public SolutionTask {
+    public:
+        ProcessSolutionTask() :
+            SolutionTask(),
+            config(),
+            report(),
+            result() {}
+
+        ProcessSolutionTask(Context::ProcessConfig config) :
+            SolutionTask(),
+            config(std::move(config)),
+            report(),
+            result() {}
+
+        ~ProcessSolutionTask() {}
+
+        void setProcessConfig(Context::ProcessConfig config) {
+            this->config = std::move(config);
+        }
+
+        void setReport(std::shared_ptr<Report<ProcessRecord>> report) {
+            this->report = std::move(report);
+        }
+
+        void call() override {
+            /** Kill the process if the task times out or the run fails fast. */
+            if (hasFileEnvironment()) {
+                MULTIGENERATOR_TRACE_SCOPE(scope, "solve", "task");
+                MULTIGENERATOR_TRACE_ARGUMENT(scope, "testcase", arg->getID());
+                result = Context::Process::run(config, getInputFileName(), getOutputFileName(), getCancellationCheck());
+            } else {
+                SolutionTask::call();
+            }
+
+            if (report)
+                report->add({ arg->getID(), result });
+        }
+
+        /**
+         * @brief Get the result of the last run.
+         * 
+         * @return the result
+         */
+        const Context::ProcessResult &getResult() const {
+            return result;
+        }
+    protected:
+        void solve(std::istream &dataIn, std::ostream &dataOut,
+            const Variable::DataConfig &) override {
+            result = Context::Process::run(config, dataIn, dataOut, getCancellationCheck());
+        }
+    private:
+        Context::ProcessConfig config;
+        std::shared_ptr<Report<ProcessRecord>> report;
+        Context::ProcessResult result;
+
+        Context::Process::CancellationCheck getCancellationCheck() const {
+            return [this]() {
+                return isCancelled();
+            };
         }
     };
 
@@ -137,7 +556,13 @@ namespace MultiGenerator::Interface {
         }
 
         void call() override {
+            MULTIGENERATOR_TRACE_SCOPE(scope, "generate", "task");
+            MULTIGENERATOR_TRACE_ARGUMENT(scope, "testcase", arg->getID());
+            MULTIGENERATOR_MEMORY_SCOPE(memory, arg->getID(), "generate");
+
             generate(inputFile->getOutputStream(), outputFile->getOutputStream(), arg->getConfig());
+            inputFile->getOutputStream().flush();
+            outputFile->getOutputStream().flush();
         }
     protected:
         /**
@@ -168,4 +593,218 @@ namespace MultiGenerator::Interface {
             );
         }
     };
-} // namespace MultiGenerator::Interface
+
+    /**
+     * @brief The result of checking the output of a candidate solution.
+     * 
+     */
+    struct CheckResult {
+        std::string testcase;
+        int candidate;
+        bool accepted;
+    };
+
+    /**
+     * @brief A task class for executing a checker (special judge) which compares
+     * the output of a candidate solution with the standard answer.
+     * 
+     */
+    class CheckerTask : public Workflow::Task {
+    public:
+        CheckerTask() :
+            Workflow::Task(),
+            problemName(),
+            outputExtension(),
+            candidate(0),
+            report(),
+            inputFile(),
+            answerFile(),
+            outputFile() {}
+
+        ~CheckerTask() {}
+
+        void setProblemName(const std::string &problemName) {
+            this->problemName = problemName;
+        }
+
+        /**
+         * @brief Set the candidate to be checked. Call it before setArgument().
+         * 
+         * @param candidate the index of the candidate
+         * @param outputExtension the extension of the output file of the candidate
+         */
+        void setCandidate(int candidate, const std::string &outputExtension) {
+            this->candidate = candidate;
+            this->outputExtension = outputExtension;
+        }
+
+        void setReport(std::shared_ptr<Report<CheckResult>> report) {
+            this->report = std::move(report);
+        }
+
+        void setArgument(std::shared_ptr<Variable::Argument> arg) override {
+            Workflow::Task::setArgument(std::move(arg));
+            initEnvironment();
+        }
+
+        void call() override {
+            MULTIGENERATOR_TRACE_SCOPE(scope, "check", "task");
+            MULTIGENERATOR_TRACE_ARGUMENT(scope, "testcase", arg->getID());
+
+            bool accepted = check(inputFile->getInputStream(), answerFile->getInputStream(),
+                outputFile->getInputStream(), arg->getConfig());
+
+            if (report)
+                report->add({ arg->getID(), candidate, accepted });
+        }
+    protected:
+        /**
+         * @brief Check whether the output of the candidate is correct. You have
+         * to implement this method to use your own checker.
+         * 
+         * @param dataIn the stream of the file of the input data
+         * @param answer the stream of the file of the standard answer
+         * @param output the stream of the file of the output of the candidate
+         * @param config the specific configures for the checker
+         * @return true if the output is accepted
+         */
+        virtual bool check(std::istream &dataIn, std::istream &answer, std::istream &output,
+            const Variable::DataConfig &config) = 0;
+    private:
+        std::string problemName;
+        std::string outputExtension;
+        int candidate;
+        std::shared_ptr<Report<CheckResult>> report;
+        std::unique_ptr<Context::Environment> inputFile;
+        std::unique_ptr<Context::Environment> answerFile;
+        std::unique_ptr<Context::Environment> outputFile;
+
+        void initEnvironment() {
+            inputFile = std::make_unique<Context::Environment>(
+                std::make_unique<Context::FileInputStream>(problemName + arg->getID() + ".in"),
+                std::unique_ptr<Context::OutputStream>()
+            );
+            answerFile = std::make_unique<Context::Environment>(
+                std::make_unique<Context::FileInputStream>(problemName + arg->getID() + ".out"),
+                std::unique_ptr<Context::OutputStream>()
+            );
+            outputFile = std::make_unique<Context::Environment>(
+                std::make_unique<Context::FileInputStream>(
+                    problemName + arg->getID() + outputExtension),
+                std::unique_ptr<Context::OutputStream>()
+            );
+        }
+    };
+
+    /**
+     * @brief A checker which accepts the output if its tokens separated by
+     * whitespaces are the same as the standard answer.
+     * 
+     */
+    class TokenCheckerTask : public CheckerTask {
+    public:
+        TokenCheckerTask() :
+            CheckerTask() {}
+
+        ~TokenCheckerTask() {}
+    protected:
+        bool check(std::istream &, std::istream &answer, std::istream &output,
+            const Variable::DataConfig &) override {
+            std::string expected, found;
+
+            while (true) {
+                bool hasExpected = static_cast<bool>(answer >> expected);
+                bool hasFound = static_cast<bool>(output >> found);
+
+                if (hasExpected != hasFound)
+                    return false;
+
+                if (!hasExpected)
+                    return true;
+
+                if (expected != found)
+                    return false;
+            }
+        }
+    };
+
+    /**
+     * @brief The result of validating the input data of a test case.
+     * 
+     */
+    struct ValidationResult {
+        std::string testcase;
+        bool valid;
+    };
+
+    /**
+     * @brief A task class for executing a validator which checks the input data
+     * against the constraints while the generator is still writing it. The
+     * remaining stages of the test case are skipped if the data is invalid.
+     * 
+     */
+    class ValidatorTask : public Workflow::Task {
+    public:
+        ValidatorTask() :
+            Workflow::Task(),
+            pipe(),
+            report(),
+            inputFile() {}
+
+        ~ValidatorTask() {}
+
+        /**
+         * @brief Set the pipe written by the generator. Call it before setArgument().
+         * 
+         * @param pipe the pipe
+         */
+        void setPipe(std::shared_ptr<Context::Pipe> pipe) {
+            this->pipe = std::move(pipe);
+        }
+
+        void setReport(std::shared_ptr<Report<ValidationResult>> report) {
+            this->report = std::move(report);
+        }
+
+        void setArgument(std::shared_ptr<Variable::Argument> arg) override {
+            Workflow::Task::setArgument(std::move(arg));
+            initEnvironment();
+        }
+
+        void call() override {
+            MULTIGENERATOR_TRACE_SCOPE(scope, "validate", "task");
+            MULTIGENERATOR_TRACE_ARGUMENT(scope, "testcase", arg->getID());
+
+            bool valid = validate(inputFile->getInputStream(), arg->getConfig());
+            /** Drop the rest of the data instead of buffering it. */
+            pipe->closeRead();
+
+            if (!valid)
+                groupToken.cancel();
+
+            if (report)
+                report->add({ arg->getID(), valid });
+        }
+    protected:
+        /**
+         * @brief Check whether the input data satisfies the constraints. You have
+         * to implement this method to use your own validator.
+         * 
+         * @param dataIn the stream of the input data being generated
+         * @param config the specific configures for the validator
+         * @return true if the data is valid
+         */
+        virtual bool validate(std::istream &dataIn, const Variable::DataConfig &config) = 0;
+    private:
+        std::shared_ptr<Context::Pipe> pipe;
+        std::shared_ptr<Report<ValidationResult>> report;
+        std::unique_ptr<Context::Environment> inputFile;
+
+        void initEnvironment() {
+            inputFile = std::make_unique<Context::Environment>(
+                std::make_unique<Context::PipeInputStream>(pipe),
+                std::unique_ptr<Context::OutputStream>()
+            );
+        }
+    };
+} // namespace MultiGenerator::Interface
\ No newline at end of file
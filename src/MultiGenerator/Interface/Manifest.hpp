@@ -0,0 +1,228 @@
+/**
+ * @file MultiGenerator/Interface/Manifest.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief This file contains the manifest, a plain text file listing the test
+ * cases of a problem, so that the test cases can be changed without compiling
+ * the generator again.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <charconv>
+#include <unordered_map>
+#include <exception>
+
+#include <MultiGenerator/Variable/DataConfig.hpp>
+#include <MultiGenerator/Variable/Argument.hpp>
+
+namespace MultiGenerator::Interface {
+    class ManifestException : public std::exception {
+    public:
+        ManifestException(const std::string &reason) :
+            msg("ManifestException: " + reason) {}
+
+        ManifestException(int line, const std::string &reason) :
+            msg("ManifestException: Line " + std::to_string(line) + ": " + reason) {}
+
+        const char *what() const noexcept override {
+            return msg.c_str();
+        }
+    private:
+        std::string msg;
+    };
+
+    /**
+     * @brief A test case in a manifest.
+     *
+     */
+    struct ManifestEntry {
+        /** The index of the name of its type in Manifest::getTypes(). */
+        std::size_t type;
+        std::shared_ptr<Variable::Argument> arg;
+        /** The line in the manifest, used in the messages of errors. */
+        int line;
+    };
+
+    /**
+     * @brief A list of test cases read from a plain text file. Every line is
+     * one of the following, and the words are separated by spaces:
+     *
+     *     # a comment
+     *     subtask <id> [key=value ...]
+     *     testcase <type> [key=value ...]
+     *
+     * A testcase takes the name of a type defined in the template, e.g. by
+     * NormalTemplate::define(). The test cases before the first subtask are
+     * NormalArgument numbered from 1, and the test cases after a subtask line
+     * belong to that subtask and are numbered from 1 in it. The pairs of a
+     * subtask line are the defaults of its test cases, which share them until
+     * a test case changes one. Neither keys nor values can contain spaces.
+     *
+     */
+    class Manifest {
+    public:
+        Manifest() :
+            types(),
+            typeLines(),
+            entries() {}
+
+        ~Manifest() {}
+
+        /**
+         * @brief Parse the text of a manifest.
+         *
+         * @param text the text
+         * @return the manifest
+         * @throw ManifestException if a line is invalid
+         */
+        static Manifest parse(std::string_view text) {
+            Manifest res;
+            std::unordered_map<std::string_view, std::size_t> typeIndexes;
+            std::unordered_map<int, int> nextIDs;
+            /** The subtask of the following test cases, or -1 before the first subtask. */
+            int subtask = -1;
+            /** The pairs of the current subtask and the config made of them. */
+            std::vector<std::pair<std::string, std::string>> defaultPairs;
+            Variable::DataConfig defaults;
+            std::vector<std::string_view> words;
+            std::vector<std::pair<std::string, std::string>> pairs;
+
+            for (int line = 1; !text.empty(); ++line) {
+                auto end = text.find('\n');
+                split(text.substr(0, end), words);
+                text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+                if (words.empty() || words[0].front() == '#')
+                    continue;
+
+                if (words.size() < 2)
+                    throw ManifestException(line, "\"" + std::string(words[0]) + "\" needs an argument.");
+
+                if (words[0] == "subtask") {
+                    auto id = words[1];
+
+                    if (auto [ptr, error] = std::from_chars(id.data(), id.data() + id.size(), subtask);
+                        error != std::errc() || ptr != id.data() + id.size() || subtask < 0)
+                        throw ManifestException(line, "Invalid subtask ID \"" + std::string(id) + "\".");
+
+                    getPairs(line, words, defaultPairs);
+                    defaults = Variable::DataConfig(defaultPairs);
+                } else if (words[0] == "testcase") {
+                    auto [it, isInserted] = typeIndexes.try_emplace(words[1], res.types.size());
+
+                    if (isInserted) {
+                        res.types.emplace_back(words[1]);
+                        res.typeLines.push_back(line);
+                    }
+
+                    Variable::DataConfig config = defaults;
+
+                    /** The first value of a key is taken, so the pairs of the test case go first. */
+                    if (getPairs(line, words, pairs) > 0) {
+                        pairs.insert(pairs.end(), defaultPairs.begin(), defaultPairs.end());
+                        config = Variable::DataConfig(pairs);
+                    }
+
+                    int id = ++nextIDs[subtask];
+
+                    if (subtask < 0)
+                        res.entries.push_back({ it->second, std::make_shared<Variable::NormalArgument>(id, config), line });
+                    else
+                        res.entries.push_back({ it->second, std::make_shared<Variable::SubtaskArgument>(subtask, id, config), line });
+                } else {
+                    throw ManifestException(line, "Unknown directive \"" + std::string(words[0]) + "\".");
+                }
+            }
+
+            return res;
+        }
+
+        /**
+         * @brief Read and parse a manifest file.
+         *
+         * @param fileName the name of the file
+         * @return the manifest
+         * @throw ManifestException if the file can't be read or a line is invalid
+         */
+        static Manifest load(const std::string &fileName) {
+            std::ifstream file(fileName, std::ios::binary);
+
+            if (!file)
+                throw ManifestException("Can't open the manifest \"" + fileName + "\".");
+
+            std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            return parse(text);
+        }
+
+        /**
+         * @brief Get the names of the types, in the order of their first test cases.
+         *
+         */
+        const std::vector<std::string> &getTypes() const {
+            return types;
+        }
+
+        /**
+         * @brief Get the line of the first test case of a type.
+         *
+         * @param type the index of the type in getTypes()
+         */
+        int getTypeLine(std::size_t type) const {
+            return typeLines[type];
+        }
+
+        const std::vector<ManifestEntry> &getEntries() const {
+            return entries;
+        }
+    private:
+        std::vector<std::string> types;
+        /** The line of the first test case of every type. */
+        std::vector<int> typeLines;
+        std::vector<ManifestEntry> entries;
+
+        static void split(std::string_view str, std::vector<std::string_view> &words) {
+            static constexpr char SPACES[] = " \t\r";
+            words.clear();
+
+            for (auto first = str.find_first_not_of(SPACES); first != std::string_view::npos;
+                first = str.find_first_not_of(SPACES, first)) {
+                auto last = std::min(str.find_first_of(SPACES, first), str.size());
+                words.push_back(str.substr(first, last - first));
+                first = last;
+            }
+        }
+
+        /**
+         * @brief Get the pairs key=value after the first two words.
+         *
+         * @return how many pairs there are
+         */
+        static std::size_t getPairs(int line, const std::vector<std::string_view> &words,
+            std::vector<std::pair<std::string, std::string>> &pairs) {
+            pairs.clear();
+
+            for (std::size_t i = 2; i < words.size(); ++i) {
+                auto equal = words[i].find('=');
+
+                if (equal == 0 || equal == std::string_view::npos)
+                    throw ManifestException(line, "\"" + std::string(words[i]) + "\" isn't a pair key=value.");
+
+                pairs.emplace_back(words[i].substr(0, equal), words[i].substr(equal + 1));
+            }
+
+            return pairs.size();
+        }
+    };
+} // namespace MultiGenerator::Interface
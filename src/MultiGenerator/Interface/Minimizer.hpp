@@ -0,0 +1,249 @@
+/**
+ * @file MultiGenerator/Interface/Minimizer.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief A minimizer which shrinks a failing input in parallel.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <exception>
+
+#include <MultiGenerator/Context/Environment.hpp>
+#include <MultiGenerator/Executor/Channel.hpp>
+#include <MultiGenerator/Executor/ThreadPool.hpp>
+#include <MultiGenerator/Variable/Argument.hpp>
+#include <MultiGenerator/Workflow/Runner.hpp>
+#include <MultiGenerator/Interface/Component.hpp>
+#include <MultiGenerator/Interface/Reducer.hpp>
+
+namespace MultiGenerator::Interface {
+    class InputNotFailingException : public std::exception {
+    public:
+        const char *what() const noexcept override {
+            return "InputNotFailingException: The input to be minimized doesn't fail.";
+        }
+    };
+
+    /**
+     * @brief Run a solution on an input in memory without touching any file.
+     *
+     * @tparam Solution the solution derived from SolutionTask
+     * @param input the content of the input
+     * @param config the config passed to the solution
+     * @return the content of the output
+     */
+    template <typename Solution>
+    std::string solveInMemory(const std::string &input,
+        const Variable::DataConfig &config = Variable::DataConfig()) {
+        static_assert(std::is_base_of_v<SolutionTask, Solution>,
+            "Solution must be a derived class of SolutionTask");
+
+        auto os = std::make_unique<Context::StringOutputStream>();
+        auto &output = *os;
+        auto arg = std::make_shared<Variable::NormalArgument>(0, config);
+        prepareParameters<Solution>(*arg);
+        Solution solution;
+        solution.setArgument(std::move(arg));
+        solution.setEnvironment(std::make_unique<Context::Environment>(
+            std::make_unique<Context::StringInputStream>(input),
+            std::move(os)
+        ));
+        solution.call();
+        return output.getContent();
+    }
+
+    /**
+     * @brief Create a predicate which checks whether two solutions give different
+     * outputs. An input on which any solution throws is regarded as passed.
+     *
+     * @tparam Reference the reference solution
+     * @tparam Candidate the solution to be compared with the reference
+     * @param config the config passed to both solutions
+     * @return the predicate
+     */
+    template <typename Reference, typename Candidate>
+    std::function<bool(const std::string &)> mismatch(
+        const Variable::DataConfig &config = Variable::DataConfig()) {
+        return [config](const std::string &input) {
+            try {
+                return solveInMemory<Reference>(input, config)
+                    != solveInMemory<Candidate>(input, config);
+            } catch (...) {
+                return false;
+            }
+        };
+    }
+
+    /**
+     * @brief A runner which checks whether one candidate still fails.
+     *
+     */
+    class CandidateRunner : public Workflow::Runner {
+    public:
+        using Result = std::pair<std::size_t, bool>;
+
+        CandidateRunner(std::size_t index, std::string candidate,
+            const std::function<bool(const std::string &)> &failing,
+            Executor::Sender<Result> sender) :
+            Workflow::Runner(),
+            index(index),
+            candidate(std::move(candidate)),
+            failing(failing),
+            sender(std::move(sender)) {}
+
+        ~CandidateRunner() {}
+    private:
+        std::size_t index;
+        std::string candidate;
+        const std::function<bool(const std::string &)> &failing;
+        Executor::Sender<Result> sender;
+
+        void run() override {
+            bool res = false;
+            /** Never let an exception escape from the worker. */
+            try {
+                res = failing(candidate);
+            } catch (...) {
+                res = false;
+            }
+
+            sender.send({ index, res });
+            sender.reset();
+        }
+    };
+
+    /**
+     * @brief A delta-debugging minimizer. It applies the reducers repeatedly and
+     * checks the candidates in parallel, keeping the smallest input which still
+     * fails until no reducer makes progress.
+     *
+     */
+    class Minimizer {
+    public:
+        using Predicate = std::function<bool(const std::string &)>;
+
+        /**
+         * @brief Construct a new Minimizer object.
+         *
+         * @param failing the predicate which returns true if an input still fails
+         * @param parallelCount how many candidates can be checked at the same time
+         */
+        Minimizer(Predicate failing, int parallelCount) :
+            failing(std::move(failing)),
+            parallelCount(parallelCount),
+            reducers(),
+            evaluationCount(0) {}
+
+        ~Minimizer() {}
+
+        /**
+         * @brief Add a reducer. Reducers are applied in the order of adding.
+         *
+         * @param reducer the reducer
+         */
+        void addReducer(std::unique_ptr<Reducer> reducer) {
+            reducers.push_back(std::move(reducer));
+        }
+
+        /**
+         * @brief Minimize a failing input. Throw if the input doesn't fail.
+         *
+         * @param input the failing input
+         * @return the smallest failing input found
+         */
+        std::string minimize(const std::string &input) {
+            if (!failing(input))
+                throw InputNotFailingException();
+
+            Executor::ThreadPool pool(parallelCount);
+            std::string current = input;
+            bool progress = true;
+
+            while (progress) {
+                progress = false;
+
+                for (auto &reducer : reducers) {
+                    while (auto smaller = reduceOnce(pool, *reducer, current)) {
+                        current = std::move(smaller.value());
+                        progress = true;
+                    }
+                }
+            }
+
+            pool.stop();
+            return current;
+        }
+
+        /**
+         * @brief Get how many candidates have been checked.
+         *
+         * @return the count
+         */
+        int getEvaluationCount() const {
+            return evaluationCount;
+        }
+    private:
+        Predicate failing;
+        int parallelCount;
+        std::vector<std::unique_ptr<Reducer>> reducers;
+        int evaluationCount;
+
+        /**
+         * @brief Check the candidates of input batch by batch until some of them
+         * fail, and return the smallest one.
+         *
+         */
+        std::optional<std::string> reduceOnce(Executor::ThreadPool &pool, Reducer &reducer,
+            const std::string &input) {
+            reducer.reset(input);
+
+            while (true) {
+                std::vector<std::string> batch;
+
+                while (static_cast<int>(batch.size()) < parallelCount) {
+                    auto candidate = reducer.next();
+
+                    if (!candidate.has_value())
+                        break;
+
+                    batch.push_back(std::move(candidate.value()));
+                }
+
+                if (batch.empty())
+                    return std::nullopt;
+
+                Executor::Receiver<CandidateRunner::Result> receiver;
+
+                for (std::size_t i = 0; i < batch.size(); ++i) {
+                    pool.execute<CandidateRunner>(i, batch[i], failing,
+                        Executor::Channel<CandidateRunner::Result>::open(receiver));
+                }
+
+                std::optional<std::size_t> best;
+
+                for (std::size_t i = 0; i < batch.size(); ++i) {
+                    auto [index, res] = receiver.receive().value();
+                    ++evaluationCount;
+
+                    if (!res)
+                        continue;
+                    /** Prefer the shorter one, then the earlier one. */
+                    if (!best.has_value() || batch[index].size() < batch[best.value()].size()
+                        || (batch[index].size() == batch[best.value()].size() && index < best.value()))
+                        best = index;
+                }
+
+                if (best.has_value())
+                    return std::move(batch[best.value()]);
+            }
+        }
+    };
+} // namespace MultiGenerator::Interface
\ No newline at end of file
@@ -0,0 +1,342 @@
+/**
+ * @file MultiGenerator/Interface/Reducer.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief Some structure-aware reducers used to shrink a failing input.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace MultiGenerator::Interface {
+    /**
+     * @brief An interface which enumerates the reductions of an input. Every
+     * candidate must be strictly simpler than the input so that minimizing
+     * always terminates.
+     *
+     */
+    class Reducer {
+    public:
+        Reducer() {}
+
+        virtual ~Reducer() {}
+
+        /**
+         * @brief Start enumerating the reductions of input.
+         *
+         * @param input the input to be reduced
+         */
+        virtual void reset(const std::string &input) = 0;
+
+        /**
+         * @brief Get the next candidate. The more promising candidates should be
+         * returned first.
+         *
+         * @return the next candidate or std::nullopt if there is no more one
+         */
+        virtual std::optional<std::string> next() = 0;
+    };
+
+    /**
+     * @brief A reducer which removes chunks of lines. The size of chunks halves
+     * from a half of all lines to a single line.
+     *
+     */
+    class LineReducer : public Reducer {
+    public:
+        /**
+         * @brief Construct a new LineReducer object.
+         *
+         * @param fixedLineCount how many lines at the beginning are never removed
+         */
+        LineReducer(int fixedLineCount = 0) :
+            Reducer(),
+            lines(),
+            trailingNewline(false),
+            fixedLineCount(fixedLineCount),
+            first(0),
+            last(0),
+            chunk(0),
+            position(0) {}
+
+        ~LineReducer() {}
+
+        void reset(const std::string &input) override {
+            split(input);
+            setRange(std::min(lines.size(), static_cast<std::size_t>(fixedLineCount)),
+                lines.size());
+        }
+
+        std::optional<std::string> next() override {
+            while (chunk != 0) {
+                if (position < last) {
+                    std::size_t begin = position;
+                    position = std::min(position + chunk, last);
+                    return build(begin, position);
+                }
+
+                chunk = (chunk == 1 ? 0 : (chunk + 1) / 2);
+                position = first;
+            }
+
+            return std::nullopt;
+        }
+    protected:
+        std::vector<std::string> lines;
+        bool trailingNewline;
+
+        /**
+         * @brief Only remove lines in [first, last).
+         *
+         * @param first the first removable line
+         * @param last the line after the last removable line
+         */
+        void setRange(std::size_t first, std::size_t last) {
+            this->first = first;
+            this->last = std::max(first, last);
+            chunk = (this->last - first + 1) / 2;
+            position = first;
+        }
+
+        /**
+         * @brief Build the candidate without the lines in [begin, end).
+         *
+         * @param begin the first line removed
+         * @param end the line after the last line removed
+         * @return the candidate
+         */
+        virtual std::string build(std::size_t begin, std::size_t end) const {
+            return join(begin, end);
+        }
+
+        std::string join(std::size_t begin, std::size_t end) const {
+            std::string res;
+            bool isFirst = true;
+
+            for (std::size_t i = 0; i < lines.size(); ++i) {
+                if (i >= begin && i < end)
+                    continue;
+
+                if (!isFirst)
+                    res += '\n';
+
+                res += lines[i];
+                isFirst = false;
+            }
+
+            if (trailingNewline)
+                res += '\n';
+
+            return res;
+        }
+    private:
+        int fixedLineCount;
+        std::size_t first;
+        std::size_t last;
+        std::size_t chunk;
+        std::size_t position;
+
+        void split(const std::string &input) {
+            lines.clear();
+            std::size_t begin = 0;
+
+            while (begin < input.size()) {
+                std::size_t end = input.find('\n', begin);
+
+                if (end == std::string::npos)
+                    end = input.size();
+
+                lines.push_back(input.substr(begin, end - begin));
+                begin = end + 1;
+            }
+
+            trailingNewline = (!input.empty() && input.back() == '\n');
+        }
+    };
+
+    /**
+     * @brief A reducer which drops edges from a graph. The edges are the lines
+     * right after the line containing the edge count, which is updated in every
+     * candidate.
+     *
+     */
+    class EdgeReducer : public LineReducer {
+    public:
+        /**
+         * @brief Construct a new EdgeReducer object.
+         *
+         * @param countLine the line which contains the edge count
+         * @param countToken the index of the edge count in that line
+         */
+        EdgeReducer(int countLine = 0, int countToken = 1) :
+            LineReducer(),
+            countLine(static_cast<std::size_t>(countLine)),
+            countToken(countToken),
+            edgeCount(0) {}
+
+        ~EdgeReducer() {}
+
+        void reset(const std::string &input) override {
+            LineReducer::reset(input);
+            edgeCount = 0;
+
+            if (countLine < lines.size()) {
+                std::istringstream iss(lines[countLine]);
+                std::string token;
+
+                for (int i = 0; i <= countToken && iss >> token; ++i)
+                    if (i == countToken)
+                        edgeCount = std::strtoull(token.c_str(), nullptr, 10);
+            }
+
+            setRange(countLine + 1, std::min(lines.size(), countLine + 1 + edgeCount));
+        }
+    protected:
+        std::string build(std::size_t begin, std::size_t end) const override {
+            auto res = join(begin, end);
+            /** Locate the count token, which stays at the same place of the result. */
+            std::size_t offset = 0;
+
+            for (std::size_t i = 0; i < countLine; ++i)
+                offset += lines[i].size() + 1;
+
+            const std::string &line = lines[countLine];
+            std::size_t pos = 0;
+
+            for (int i = 0; ; ++i) {
+                while (pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos])))
+                    ++pos;
+
+                std::size_t tokenEnd = pos;
+
+                while (tokenEnd < line.size() && !std::isspace(static_cast<unsigned char>(line[tokenEnd])))
+                    ++tokenEnd;
+
+                if (i == countToken) {
+                    auto count = std::to_string(edgeCount - (end - begin));
+                    return res.replace(offset + pos, tokenEnd - pos, count);
+                }
+
+                pos = tokenEnd;
+            }
+        }
+    private:
+        std::size_t countLine;
+        int countToken;
+        std::size_t edgeCount;
+    };
+
+    /**
+     * @brief A reducer which shrinks every integer towards zero. It tries zero,
+     * a half of the value and the value closer to zero by one in order.
+     *
+     */
+    class NumberReducer : public Reducer {
+    public:
+        NumberReducer() :
+            Reducer(),
+            input(),
+            numbers(),
+            current(0),
+            step(0) {}
+
+        ~NumberReducer() {}
+
+        void reset(const std::string &input) override {
+            this->input = input;
+            numbers.clear();
+            current = 0;
+            step = 0;
+
+            std::size_t pos = 0;
+
+            while (pos < input.size()) {
+                if (std::isspace(static_cast<unsigned char>(input[pos]))) {
+                    ++pos;
+                    continue;
+                }
+
+                std::size_t end = pos;
+
+                while (end < input.size() && !std::isspace(static_cast<unsigned char>(input[end])))
+                    ++end;
+
+                if (auto value = parse(input.substr(pos, end - pos)); value.has_value())
+                    numbers.push_back({ pos, end - pos, value.value() });
+
+                pos = end;
+            }
+        }
+
+        std::optional<std::string> next() override {
+            while (current < numbers.size()) {
+                const auto &number = numbers[current];
+                auto value = nextValue(number.value);
+
+                if (!value.has_value()) {
+                    ++current;
+                    step = 0;
+                    continue;
+                }
+
+                std::string res = input;
+                return res.replace(number.position, number.length, std::to_string(value.value()));
+            }
+
+            return std::nullopt;
+        }
+    private:
+        struct Number {
+            std::size_t position;
+            std::size_t length;
+            long long value;
+        };
+
+        std::string input;
+        std::vector<Number> numbers;
+        std::size_t current;
+        int step;
+
+        std::optional<long long> nextValue(long long value) {
+            while (step < 3) {
+                long long res = 0;
+
+                switch (step++) {
+                case 0: res = 0; break;
+                case 1: res = value / 2; break;
+                default: res = (value > 0 ? value - 1 : value + 1); break;
+                }
+                /** Skip the values which aren't closer to zero or were tried before. */
+                if (value == 0 || (step > 1 && res == 0) || (step == 3 && res == value / 2))
+                    continue;
+
+                return res;
+            }
+
+            return std::nullopt;
+        }
+
+        static std::optional<long long> parse(const std::string &token) {
+            std::size_t begin = (!token.empty() && token[0] == '-' ? 1 : 0);
+
+            if (begin == token.size() || token.size() - begin > 18)
+                return std::nullopt;
+
+            for (std::size_t i = begin; i < token.size(); ++i)
+                if (!std::isdigit(static_cast<unsigned char>(token[i])))
+                    return std::nullopt;
+
+            return std::stoll(token);
+        }
+    };
+} // namespace MultiGenerator::Interface
\ No newline at end of file
@@ -0,0 +1,59 @@
+/**
+ * @file MultiGenerator/Interface/Report.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief A thread-safe collection of the results reported by tasks.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+namespace MultiGenerator::Interface {
+    /**
+     * @brief A thread-safe collection of the results reported by tasks.
+     *
+     * @tparam Record the type of one result
+     */
+    template <typename Record>
+    class Report {
+    public:
+        Report() :
+            records(),
+            mtx() {}
+
+        ~Report() {}
+
+        void add(Record record) {
+            std::lock_guard<std::mutex> lock(mtx);
+            records.push_back(std::move(record));
+        }
+
+        /**
+         * @brief Get a copy of all results reported so far.
+         *
+         * @return the results
+         */
+        std::vector<Record> getRecords() const {
+            std::lock_guard<std::mutex> lock(mtx);
+            return records;
+        }
+
+        std::size_t size() const {
+            std::lock_guard<std::mutex> lock(mtx);
+            return records.size();
+        }
+
+        void clear() {
+            std::lock_guard<std::mutex> lock(mtx);
+            records.clear();
+        }
+    private:
+        std::vector<Record> records;
+        mutable std::mutex mtx;
+    };
+} // namespace MultiGenerator::Interface
\ No newline at end of file
@@ -10,35 +10,653 @@
  */
 #pragma once
 
+#include <string>
 #include <vector>
+#include <unordered_map>
+#include <utility>
+#include <typeinfo>
+#include <cstdlib>
+#include <limits>
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <iterator>
+#include <functional>
 
 #include <MultiGenerator/Context/Environment.hpp>
+#include <MultiGenerator/Context/Memory.hpp>
 #include <MultiGenerator/Executor/TaskExecutor.hpp>
+#include <MultiGenerator/Executor/ProcessExecutor.hpp>
 #include <MultiGenerator/Workflow/TaskGroup.hpp>
+#include <MultiGenerator/Workflow/Registry.hpp>
+#include <MultiGenerator/Variable/Argument.hpp>
+#include <MultiGenerator/Variable/Sweep.hpp>
 #include <MultiGenerator/Interface/Component.hpp>
 #include <MultiGenerator/Interface/Utility.hpp>
+#include <MultiGenerator/Interface/Calibration.hpp>
+#include <MultiGenerator/Interface/Manifest.hpp>
 
 namespace MultiGenerator::Interface {
     class Template {
     public:
         Template(const std::string &problemName) :
             problemName(problemName),
-            groups() {}
+            validationReport(std::make_shared<Report<ValidationResult>>()),
+            processReport(std::make_shared<Report<ProcessRecord>>()),
+            ioParallelCount(0),
+            memoryBudget(0),
+            maxActiveGroupCount(0),
+            batchGranularity(0),
+            failurePolicy(Executor::FailurePolicy::ContinueAndReport),
+            taskTimeLimit(0),
+            progressReporter(),
+            memoryProfile(std::make_shared<Context::MemoryProfile>()),
+            costHint(),
+            solutions(),
+            registry(),
+            layouts(),
+            definitions(),
+            groups(),
+            sources(),
+            nextSource(0),
+            isPulling(false),
+            windowSize(DEFAULT_WINDOW_SIZE) {}
+
+        /** The registered factories refer to this template. */
+        Template(const Template &) = delete;
+
+        Template &operator=(const Template &) = delete;
         
         ~Template() {}
 
-        void execute(int parallelCount) {
+        /**
+         * @brief Execute all test cases. A test case whose generator, solution or
+         * checker throws is stopped and reported instead of killing the program.
+         * 
+         * @param parallelCount how many tasks are executed at the same time
+         * @return the test cases which failed
+         */
+        std::vector<Executor::Failure> execute(int parallelCount) {
+            Executor::TaskExecutor executor;
+            return run(executor, parallelCount);
+        }
+
+        /**
+         * @brief Same as execute(), but more tasks run at the same time when
+         * some of them are blocked, such as external solutions reading pipes.
+         * 
+         * @param parallelCount how many tasks use the CPU at the same time
+         * @param maxParallelCount how many tasks can be executed at most
+         * @return the test cases which failed
+         */
+        std::vector<Executor::Failure> execute(int parallelCount, int maxParallelCount) {
             Executor::TaskExecutor executor;
-            executor.execute(groups, parallelCount);
+            executor.setElasticity(maxParallelCount, std::chrono::seconds(1));
+            return run(executor, parallelCount);
+        }
+
+        /**
+         * @brief Choose whether the other test cases go on after one fails.
+         * FailurePolicy::FailFast skips all test cases which haven't finished.
+         * 
+         * @param failurePolicy the policy
+         */
+        void setFailurePolicy(Executor::FailurePolicy failurePolicy) {
+            this->failurePolicy = failurePolicy;
+        }
+
+        /**
+         * @brief Fail a generator, solution or checker which runs longer than
+         * taskTimeLimit. The test case and the task are reported by execute().
+         * An external solution is killed, while the other tasks can only be
+         * skipped once they return.
+         * 
+         * @param taskTimeLimit the limit, or 0 for no limit
+         */
+        void setTaskTimeLimit(std::chrono::milliseconds taskTimeLimit) {
+            this->taskTimeLimit = taskTimeLimit;
+        }
+
+        /**
+         * @brief Report the progress during execute(), e.g. with a
+         * Executor::StreamProgressSink printing to std::cerr.
+         * 
+         * @param progressReporter the reporter, or nullptr to report nothing
+         */
+        void setProgressReporter(std::shared_ptr<Executor::ProgressReporter> progressReporter) {
+            this->progressReporter = std::move(progressReporter);
+        }
+
+        /**
+         * @brief Estimate the relative cost of every test case from its config,
+         * which makes the remaining time reported more accurate when the test
+         * cases differ in size.
+         * 
+         * @param costHint the function returning the cost of a test case
+         */
+        void setCostHint(std::function<double(const Variable::DataConfig &)> costHint) {
+            this->costHint = std::move(costHint);
+        }
+
+        /**
+         * @brief Generate the input data with another ioParallelCount worker(s),
+         * so that writing files overlaps with the solutions and doesn't take
+         * their slots.
+         * 
+         * @param ioParallelCount the count, or 0 to share the workers of solutions
+         */
+        void setIOParallelCount(int ioParallelCount) {
+            this->ioParallelCount = ioParallelCount;
+        }
+
+        /**
+         * @brief Execute several very small test cases in one runner, so that a
+         * runner takes about batchGranularity. Every test case still has its own
+         * files. With setIOParallelCount() or a validator, the input data is still
+         * generated test case by test case, and only the solutions are packed.
+         * 
+         * @param batchGranularity the target time of a runner, or 0 to disable it
+         */
+        void setBatchGranularity(std::chrono::nanoseconds batchGranularity) {
+            this->batchGranularity = batchGranularity;
+        }
+
+        /**
+         * @brief Start a test case only while the total estimated memory of the
+         * running test cases stays under memoryBudget. The estimates are given
+         * to add().
+         * 
+         * @param memoryBudget the budget in bytes, or 0 for no limit
+         */
+        void setMemoryBudget(std::size_t memoryBudget) {
+            this->memoryBudget = memoryBudget;
+        }
+
+        /**
+         * @brief Limit how many test cases run at the same time, which also
+         * limits how many inputs are waiting for their solutions.
+         * 
+         * @param maxActiveGroupCount the count, or 0 for no limit
+         */
+        void setMaxActiveGroupCount(int maxActiveGroupCount) {
+            this->maxActiveGroupCount = maxActiveGroupCount;
+        }
+
+        /**
+         * @brief Create at most windowSize test cases of the lists given to add()
+         * at a time. The next window is created while the current one runs.
+         * 
+         * @param windowSize the count
+         */
+        void setWindowSize(std::size_t windowSize) {
+            this->windowSize = std::max<std::size_t>(windowSize, 1);
+        }
+
+        /**
+         * @brief Execute every test case in one of workerCount worker processes,
+         * which are this program started again in worker mode. A test case whose
+         * worker crashes is retried in a new worker. In a worker process, this
+         * serves the coordinator and then exits, so everything before it in main()
+         * runs again in every worker and must be free of side effects. The reports
+         * are filled in the workers and stay empty in the coordinator. The lists
+         * given to add() are taken all at once, since a worker needs the types
+         * of all test cases. With setTaskTimeLimit(), a worker which doesn't
+         * reply within the limit for each task of a test case is killed, and
+         * the test case fails.
+         * 
+         * @param workerCount how many worker processes run at the same time
+         * @return the test cases which failed
+         */
+        std::vector<Executor::RemoteFailure> executeInProcesses(int workerCount) {
+            while (pull(groups.size(), std::numeric_limits<std::size_t>::max()) > 0) {}
+
+            if (Executor::ProcessExecutor::isWorker()) {
+                Executor::ProcessExecutor::serve(registry, 1, taskTimeLimit);
+                std::exit(0);
+            }
+
+            Executor::ProcessExecutor executor;
+            executor.setTaskTimeLimit(taskTimeLimit);
+            return executor.execute(groups, workerCount);
+        }
+
+        /**
+         * @brief Add the test cases of a manifest. Nothing is added if a type in
+         * it isn't defined.
+         * 
+         * @param manifest the manifest
+         * @throw ManifestException if a type isn't defined
+         */
+        void load(const Manifest &manifest) {
+            std::vector<const std::function<void(std::shared_ptr<Variable::Argument>)> *> adds;
+            adds.reserve(manifest.getTypes().size());
+
+            for (std::size_t i = 0; i < manifest.getTypes().size(); ++i) {
+                const auto &type = manifest.getTypes()[i];
+                auto it = definitions.find(type);
+
+                if (it == definitions.end())
+                    throw ManifestException(manifest.getTypeLine(i), "Undefined type \"" + type + "\".");
+
+                adds.push_back(&it->second);
+            }
+
+            for (const auto &entry : manifest.getEntries())
+                (*adds[entry.type])(entry.arg);
+        }
+
+        /**
+         * @brief Rerun the standard solution of every test case on the input data
+         * generated by execute() before, and measure every run. The answers are
+         * written to other files, so the standard answers are kept. Only the
+         * test cases added one by one are measured: the test cases of the lists
+         * given to add() are dropped after their windows, so that the memory
+         * doesn't grow with the count of them.
+         * 
+         * @param config the runs and the cache modes to measure
+         * @return the times of every test case and subtask
+         */
+        CalibrationReport calibrate(const CalibrationConfig &config = CalibrationConfig()) const {
+            Calibrator calibrator(config);
+
+            for (const auto &[arg, constructor] : solutions) {
+                calibrator.add(arg, [&constructor = constructor]() {
+                    auto ptr = constructor();
+                    ptr->setOutputExtension(CALIBRATION_EXTENSION);
+                    return ptr;
+                }, problemName + arg->getID() + ".in", problemName + arg->getID() + CALIBRATION_EXTENSION);
+            }
+
+            return calibrator.run();
+        }
+
+        /**
+         * @brief Get the results of all validators. Call it after execute().
+         * 
+         * @return the report
+         */
+        const Report<ValidationResult> &getValidationReport() const {
+            return *validationReport;
+        }
+
+        /**
+         * @brief Get the results of all external solutions. Call it after execute().
+         * 
+         * @return the report
+         */
+        const Report<ProcessRecord> &getProcessReport() const {
+            return *processReport;
+        }
+
+        /**
+         * @brief Get the peak and total heap memory of every generate and solve
+         * stage of the last execute(). It's empty unless MULTIGENERATOR_MEMORY_TRACKING
+         * is defined in a translation unit of the program. External solutions
+         * aren't counted.
+         * 
+         * @return the records
+         */
+        std::vector<Context::MemoryRecord> getMemoryReport() const {
+            return memoryProfile->getRecords();
+        }
+
+        /**
+         * @brief Get the largest peak of all stages of a test case in the last
+         * execute(), which can be used as its memory estimate in later runs.
+         * 
+         * @param testcase the ID of the test case
+         * @return the peak in bytes, or 0 if it isn't recorded
+         */
+        long long getMemoryPeak(const std::string &testcase) const {
+            return memoryProfile->getPeak(testcase);
         }
     protected:
+        /** The extension of the output files written by calibrate(). */
+        static constexpr char CALIBRATION_EXTENSION[] = ".calibration.out";
+
         void addTaskGroup(Workflow::TaskGroup group) {
             groups.push_back(std::move(group));
         }
+
+        /**
+         * @brief Register a type of task group and add a group of this type, so
+         * that the group can be created again in a worker process.
+         * 
+         * @param type the unique name of the type
+         * @param factory the function creating a group of this type
+         * @param arg the argument of the group
+         * @param memory the estimated peak memory of the group
+         */
+        void addTaskGroup(const std::string &type, Workflow::TaskGroupRegistry::Factory factory,
+            std::shared_ptr<Variable::Argument> arg, const MemoryEstimate &memory = MemoryEstimate()) {
+            if (!registry.contain(type))
+                registry.add(type, std::move(factory));
+
+            auto group = registry.create(type, std::move(arg));
+            group.setMemoryEstimate(memory(group.getArgument()->getConfig()));
+            addTaskGroup(std::move(group));
+        }
+
+        /**
+         * @brief Add the test cases of a list lazily. They're taken and added by
+         * add in windows during execute().
+         * 
+         * @param arguments the list
+         * @param add the function adding a test case
+         */
+        void addSource(std::shared_ptr<Variable::ArgumentList> arguments,
+            std::function<void(std::shared_ptr<Variable::Argument>)> add) {
+            sources.push_back({ std::move(arguments), std::move(add) });
+        }
+
+        /**
+         * @brief Give a name to a way of adding test cases, so that a manifest
+         * can refer to it.
+         * 
+         * @param name the name used in manifests
+         * @param add the function adding a test case
+         * @throw ManifestException if name is already defined
+         */
+        void addDefinition(const std::string &name, std::function<void(std::shared_ptr<Variable::Argument>)> add) {
+            if (!definitions.emplace(name, std::move(add)).second)
+                throw ManifestException("The type \"" + name + "\" is already defined.");
+        }
+
+        /**
+         * @brief Register the standard solution of a test case for calibrate().
+         * Nothing is registered for a test case taken from a list.
+         * 
+         * @param arg the argument of the test case
+         * @param constructor the function creating the solution
+         */
+        void addSolution(std::shared_ptr<Variable::Argument> arg, Calibrator::Constructor constructor) {
+            if (isPulling)
+                return;
+
+            solutions.emplace_back(std::move(arg), std::move(constructor));
+        }
+
+        /**
+         * @brief Get the layout of a type of task group. It's built on the first
+         * call and shared by all groups of the type later, unless isShared is
+         * false, e.g. when the tasks of a group share a pipe.
+         * 
+         * @param type the name of the type
+         * @param isShared whether the layout can be shared
+         * @param build the function adding the tasks to an empty layout
+         * @return the layout
+         */
+        std::shared_ptr<Workflow::TaskLayout> getLayout(const std::string &type, bool isShared,
+            const std::function<void(Workflow::TaskLayout &)> &build) {
+            if (isShared) {
+                if (auto it = layouts.find(type); it != layouts.end())
+                    return it->second;
+            }
+
+            auto layout = std::make_shared<Workflow::TaskLayout>();
+            build(*layout);
+            layout->setType(type);
+
+            if (isShared)
+                layouts.emplace(type, layout);
+
+            return layout;
+        }
+
+        /**
+         * @brief Get a name of the type of task group made of Types.
+         * 
+         * @param kind the kind of the template
+         * @return the name
+         */
+        template <typename ...Types>
+        static std::string getTypeName(const std::string &kind) {
+            std::string res = kind;
+            ((res += std::string("|") + typeid(Types).name()), ...);
+            return res;
+        }
+
+        /**
+         * @brief Add the stage generating the input data. If Validator isn't void,
+         * it reads the data while it's being generated in the same stage through
+         * a bounded pipe. If it hasn't started when the pipe fills, e.g. with one
+         * worker, it reads the rest from the input file after the generator has
+         * finished. The stage is in ResourceClass::IO since it mostly writes files.
+         * 
+         * @tparam Generator the generator derived from GeneratingTask
+         * @tparam Validator the validator derived from ValidatorTask, or void
+         * @param layout the layout of the group
+         */
+        template <typename Generator, typename Validator>
+        void addGeneration(Workflow::TaskLayout &layout) {
+            static_assert(std::is_base_of_v<GeneratingTask, Generator>,
+                "Generator must be a derived class of GeneratingTask");
+            static_assert(std::is_void_v<Validator> || std::is_base_of_v<ValidatorTask, Validator>,
+                "Validator must be a derived class of ValidatorTask");
+
+            if constexpr (std::is_void_v<Validator>) {
+                layout.add([problemName = this->problemName]() -> std::unique_ptr<Workflow::Task> {
+                    auto ptr = std::make_unique<Generator>();
+                    ptr->setProblemName(problemName);
+                    return ptr;
+                }, Workflow::ResourceClass::IO);
+            } else {
+                auto pipe = std::make_shared<Context::Pipe>();
+                /** The generator is posted first, so the validator never waits for it in vain. */
+                layout.addParallel({
+                    [problemName = this->problemName, pipe]() -> std::unique_ptr<Workflow::Task> {
+                        auto ptr = std::make_unique<Generator>();
+                        ptr->setProblemName(problemName);
+                        ptr->setPipe(pipe);
+                        return ptr;
+                    },
+                    [report = this->validationReport, pipe]() -> std::unique_ptr<Workflow::Task> {
+                        auto ptr = std::make_unique<Validator>();
+                        ptr->setPipe(pipe);
+                        ptr->setReport(report);
+                        return ptr;
+                    }
+                }, Workflow::ResourceClass::IO);
+            }
+        }
+
+        /**
+         * @brief Add the stages of a generator returning an object. The solution
+         * receives the object, while the input file is written at the same time
+         * in ResourceClass::IO.
+         * 
+         * @tparam Generator the generator derived from ObjectGeneratingTask
+         * @tparam Solution the solution derived from ParsedSolutionTask of the
+         * same input
+         * @param layout the layout of the group
+         */
+        template <typename Generator, typename Solution>
+        void addObjectGeneration(Workflow::TaskLayout &layout) {
+            using Input = typename Generator::InputType;
+            static_assert(std::is_base_of_v<ParsedSolutionTask<Input>, Solution>,
+                "Solution must be a derived class of ParsedSolutionTask of the input of Generator");
+
+            layout.add([]() -> std::unique_ptr<Workflow::Task> {
+                return std::make_unique<Generator>();
+            });
+            layout.addParallel({
+                { [problemName = this->problemName]() -> std::unique_ptr<Workflow::Task> {
+                    auto ptr = std::make_unique<InputWritingTask<Input>>();
+                    ptr->setProblemName(problemName);
+                    return ptr;
+                }, Workflow::ResourceClass::IO },
+                { [problemName = this->problemName]() -> std::unique_ptr<Workflow::Task> {
+                    auto ptr = std::make_unique<Solution>();
+                    ptr->setProblemName(problemName);
+                    return ptr;
+                }, Workflow::ResourceClass::CPU }
+            });
+        }
     protected:
         std::string problemName;
+        std::shared_ptr<Report<ValidationResult>> validationReport;
+        std::shared_ptr<Report<ProcessRecord>> processReport;
     private:
+        int ioParallelCount;
+        std::size_t memoryBudget;
+        int maxActiveGroupCount;
+        std::chrono::nanoseconds batchGranularity;
+        Executor::FailurePolicy failurePolicy;
+        std::chrono::milliseconds taskTimeLimit;
+        std::shared_ptr<Executor::ProgressReporter> progressReporter;
+        /** The memory records of the last execute(), kept apart from other templates. */
+        std::shared_ptr<Context::MemoryProfile> memoryProfile;
+        std::function<double(const Variable::DataConfig &)> costHint;
+        std::vector<std::pair<std::shared_ptr<Variable::Argument>, Calibrator::Constructor>> solutions;
+        Workflow::TaskGroupRegistry registry;
+        /** The shared layouts by the names of their types. */
+        std::unordered_map<std::string, std::shared_ptr<Workflow::TaskLayout>> layouts;
+        /** The functions adding test cases by the names used in manifests. */
+        std::unordered_map<std::string, std::function<void(std::shared_ptr<Variable::Argument>)>> definitions;
         std::vector<Workflow::TaskGroup> groups;
+        /** The lazy lists of test cases and the functions adding them. */
+        std::vector<std::pair<std::shared_ptr<Variable::ArgumentList>,
+            std::function<void(std::shared_ptr<Variable::Argument>)>>> sources;
+        std::size_t nextSource;
+        /** Whether the test cases being added are taken from the lists. */
+        bool isPulling;
+        std::size_t windowSize;
+
+        static constexpr std::size_t DEFAULT_WINDOW_SIZE = 4096;
+
+        /**
+         * @brief Take at most count test cases from the lists and add them, so
+         * that their groups are appended to groups.
+         * 
+         * @param offset where the groups of the lists begin in groups
+         * @param count the most test cases to take
+         * @return how many test cases are taken
+         */
+        std::size_t pull(std::size_t offset, std::size_t count) {
+            std::size_t res = 0;
+            isPulling = true;
+
+            try {
+                while (res < count && nextSource < sources.size()) {
+                    auto arg = sources[nextSource].first->next();
+
+                    if (!arg.has_value()) {
+                        ++nextSource;
+                        continue;
+                    }
+
+                    sources[nextSource].second(std::move(arg.value()));
+                    ++res;
+                }
+            } catch (...) {
+                isPulling = false;
+                throw;
+            }
+
+            isPulling = false;
+
+            if (costHint) {
+                for (auto it = groups.begin() + static_cast<long>(offset); it != groups.end(); ++it)
+                    it->setCostHint(costHint(it->getArgument()->getConfig()));
+            }
+
+            return res;
+        }
+
+        /**
+         * @brief Take the next window of test cases from the lists and move their
+         * groups out of groups.
+         * 
+         * @param offset where the groups of the lists begin in groups
+         * @return the groups of the window
+         */
+        std::vector<Workflow::TaskGroup> pullWindow(std::size_t offset) {
+            pull(offset, windowSize);
+            auto first = groups.begin() + static_cast<long>(offset);
+            std::vector<Workflow::TaskGroup> res(std::make_move_iterator(first),
+                std::make_move_iterator(groups.end()));
+            groups.erase(first, groups.end());
+            return res;
+        }
+
+        std::vector<Executor::Failure> run(Executor::TaskExecutor &executor, int parallelCount) {
+            executor.setIOParallelCount(ioParallelCount);
+            executor.setMemoryBudget(memoryBudget);
+            executor.setMaxActiveGroupCount(maxActiveGroupCount);
+            executor.setBatchGranularity(batchGranularity);
+            executor.setFailurePolicy(failurePolicy);
+            executor.setTaskTimeLimit(taskTimeLimit);
+            executor.setProgressReporter(progressReporter);
+            memoryProfile = std::make_shared<Context::MemoryProfile>();
+            executor.setMemoryProfile(memoryProfile);
+
+            if (costHint) {
+                for (auto &group : groups)
+                    group.setCostHint(costHint(group.getArgument()->getConfig()));
+            }
+
+            /** Every window adds its test cases to the same progress. */
+            if (!progressReporter)
+                return runWindows(executor, parallelCount);
+
+            progressReporter->start({});
+            std::vector<Executor::Failure> res;
+
+            try {
+                res = runWindows(executor, parallelCount);
+            } catch (...) {
+                progressReporter->stop();
+                throw;
+            }
+
+            progressReporter->stop();
+            return res;
+        }
+
+        /**
+         * @brief Execute the groups added one by one, then the windows of the
+         * lists one after another.
+         * 
+         */
+        std::vector<Executor::Failure> runWindows(Executor::TaskExecutor &executor, int parallelCount) {
+            std::vector<Executor::Failure> res;
+
+            if (!groups.empty() || nextSource == sources.size())
+                res = executor.execute(groups, parallelCount);
+
+            bool isFailFast = (failurePolicy == Executor::FailurePolicy::FailFast);
+
+            if (isFailFast && !res.empty())
+                return res;
+
+            auto offset = groups.size();
+            auto window = pullWindow(offset);
+
+            while (!window.empty()) {
+                /**
+                 * The next window is prepared while this one runs, and only that
+                 * thread touches groups meanwhile. Under FailFast it's prepared
+                 * after this one succeeds, so no group is added in vain.
+                 */
+                std::future<std::vector<Workflow::TaskGroup>> next;
+
+                if (!isFailFast) {
+                    next = std::async(std::launch::async, [this, offset]() {
+                        return pullWindow(offset);
+                    });
+                }
+
+                auto failures = executor.execute(window, parallelCount);
+                res.insert(res.end(), failures.begin(), failures.end());
+
+                if (isFailFast && !res.empty())
+                    break;
+
+                window = (isFailFast ? pullWindow(offset) : next.get());
+            }
+
+            return res;
+        }
     };
 
     class NormalTemplate : public Template {
@@ -46,25 +664,147 @@ namespace MultiGenerator::Interface {
         NormalTemplate(const std::string &problemName) :
             Template(problemName) {}
 
-        template <typename Generator, typename Solution>
-        void add(std::shared_ptr<Variable::Argument> arg) {
-            static_assert(std::is_base_of_v<GeneratingTask, Generator>,
-                "Generator must be a derived class of GeneratingTask");
+        /**
+         * @brief Add a test case. The solution is skipped if Validator rejects
+         * the input data. If Generator is derived from ObjectGeneratingTask, the
+         * solution receives its object directly and Validator must be void.
+         * 
+         * @tparam Generator the generator derived from GeneratingTask or ObjectGeneratingTask
+         * @tparam Solution the solution derived from SolutionTask
+         * @tparam Validator the validator derived from ValidatorTask, or void
+         * @param arg the argument of the test case
+         * @param memory the estimated peak memory of the test case
+         */
+        template <typename Generator, typename Solution, typename Validator = void>
+        void add(std::shared_ptr<Variable::Argument> arg, const MemoryEstimate &memory = MemoryEstimate()) {
             static_assert(std::is_base_of_v<SolutionTask, Solution>,
                 "Solution must be a derived class of SolutionTask");
 
-            Workflow::TaskGroup group(arg);
-            group.add([arg, problemName = this->problemName]() -> std::unique_ptr<Workflow::Task> {
-                auto ptr = std::make_unique<Generator>();
+            static const std::string type = getTypeName<Generator, Solution, Validator>("NormalTemplate");
+
+            auto factory = [this](std::shared_ptr<Variable::Argument> arg) {
+                prepareParameters<Generator, Solution, Validator>(*arg);
+                return Workflow::TaskGroup(arg, getLayout(type, std::is_void_v<Validator>,
+                    [this](Workflow::TaskLayout &layout) {
+                    if constexpr (IsObjectGenerating<Generator>::value) {
+                        static_assert(std::is_void_v<Validator>, "An object can't be validated");
+                        addObjectGeneration<Generator, Solution>(layout);
+                    } else {
+                        addGeneration<Generator, Validator>(layout);
+                        layout.add([problemName = this->problemName]() -> std::unique_ptr<Workflow::Task> {
+                            auto ptr = std::make_unique<Solution>();
+                            ptr->setProblemName(problemName);
+                            return ptr;
+                        });
+                    }
+                }));
+            };
+
+            /** Only this is captured, so the function needs no allocation. */
+            addSolution(arg, [this]() -> std::unique_ptr<SolutionTask> {
+                auto ptr = std::make_unique<Solution>();
                 ptr->setProblemName(problemName);
                 return ptr;
             });
-            group.add([arg, problemName = this->problemName]() -> std::unique_ptr<Workflow::Task> {
-                auto ptr = std::make_unique<Solution>();
+            addTaskGroup(type, factory, std::move(arg), memory);
+        }
+
+        /**
+         * @brief Add the test cases of a list, which are created only when they're
+         * about to run. See setWindowSize().
+         * 
+         * @param arguments the list, e.g. a Variable::SweepArgumentList
+         * @param memory the estimated peak memory of every test case
+         */
+        template <typename Generator, typename Solution, typename Validator = void>
+        void add(std::shared_ptr<Variable::ArgumentList> arguments, const MemoryEstimate &memory = MemoryEstimate()) {
+            addSource(std::move(arguments), [this, memory](std::shared_ptr<Variable::Argument> arg) {
+                add<Generator, Solution, Validator>(std::move(arg), memory);
+            });
+        }
+
+        /**
+         * @brief Define a type of test case for manifests. See load().
+         * 
+         * @param name the name used in manifests
+         * @param memory the estimated peak memory of every test case
+         */
+        template <typename Generator, typename Solution, typename Validator = void>
+        void define(const std::string &name, const MemoryEstimate &memory = MemoryEstimate()) {
+            addDefinition(name, [this, memory](std::shared_ptr<Variable::Argument> arg) {
+                add<Generator, Solution, Validator>(std::move(arg), memory);
+            });
+        }
+
+        /**
+         * @brief Add a test case whose standard solution is an external program.
+         * 
+         * @tparam Generator the generator derived from GeneratingTask
+         * @tparam Validator the validator derived from ValidatorTask, or void
+         * @param arg the argument of the test case
+         * @param solution the program of the standard solution and its limits
+         * @param memory the estimated peak memory of the test case
+         */
+        template <typename Generator, typename Validator = void>
+        void add(std::shared_ptr<Variable::Argument> arg, const Context::ProcessConfig &solution,
+            const MemoryEstimate &memory = MemoryEstimate()) {
+            /** The program is a part of the type. */
+            Executor::MessageWriter writer;
+            writer.write(solution.path);
+
+            for (const auto &argument : solution.arguments)
+                writer.write(argument);
+
+            writer.write(std::to_string(solution.cpuTimeLimit));
+            writer.write(static_cast<long long>(solution.addressSpaceLimit));
+            auto type = getTypeName<Generator, Validator>("NormalTemplate") + "|" + writer.str();
+
+            auto factory = [this, solution, type](std::shared_ptr<Variable::Argument> arg) {
+                prepareParameters<Generator, Validator>(*arg);
+                return Workflow::TaskGroup(arg, getLayout(type, std::is_void_v<Validator>,
+                    [this, &solution](Workflow::TaskLayout &layout) {
+                    addGeneration<Generator, Validator>(layout);
+                    layout.add([solution, problemName = this->problemName, report = this->processReport]()
+                        -> std::unique_ptr<Workflow::Task> {
+                        auto ptr = std::make_unique<ProcessSolutionTask>(solution);
+                        ptr->setProblemName(problemName);
+                        ptr->setReport(report);
+                        return ptr;
+                    });
+                }));
+            };
+
+            addSolution(arg, [solution, problemName = this->problemName]() -> std::unique_ptr<SolutionTask> {
+                auto ptr = std::make_unique<ProcessSolutionTask>(solution);
                 ptr->setProblemName(problemName);
                 return ptr;
             });
-            addTaskGroup(std::move(group));
+            addTaskGroup(type, factory, std::move(arg), memory);
+        }
+
+        /**
+         * @brief Same as the above, but add the test cases of a list lazily.
+         * 
+         */
+        template <typename Generator, typename Validator = void>
+        void add(std::shared_ptr<Variable::ArgumentList> arguments, const Context::ProcessConfig &solution,
+            const MemoryEstimate &memory = MemoryEstimate()) {
+            addSource(std::move(arguments), [this, solution, memory](std::shared_ptr<Variable::Argument> arg) {
+                add<Generator, Validator>(std::move(arg), solution, memory);
+            });
+        }
+
+        /**
+         * @brief Define a type of test case whose standard solution is an
+         * external program for manifests.
+         * 
+         */
+        template <typename Generator, typename Validator = void>
+        void define(const std::string &name, const Context::ProcessConfig &solution,
+            const MemoryEstimate &memory = MemoryEstimate()) {
+            addDefinition(name, [this, solution, memory](std::shared_ptr<Variable::Argument> arg) {
+                add<Generator, Validator>(std::move(arg), solution, memory);
+            });
         }
     };
 
@@ -74,17 +814,151 @@ namespace MultiGenerator::Interface {
             Template(problemName) {}
 
         template <typename IntegratedGenerator>
-        void add(std::shared_ptr<Variable::Argument> arg) {
+        void add(std::shared_ptr<Variable::Argument> arg, const MemoryEstimate &memory = MemoryEstimate()) {
             static_assert(std::is_base_of_v<IntegratedGeneratingTask, IntegratedGenerator>,
                 "IntegratedGenerator must be a derived class of IntegratedGeneratingTask");
 
-            Workflow::TaskGroup group(arg);
-            group.add([arg, problemName = this->problemName]() -> std::unique_ptr<Workflow::Task> {
-                auto ptr = std::make_unique<IntegratedGeneratingTask>();
+            static const std::string type = getTypeName<IntegratedGenerator>("IntegratedTemplate");
+
+            auto factory = [this](std::shared_ptr<Variable::Argument> arg) {
+                prepareParameters<IntegratedGenerator>(*arg);
+                return Workflow::TaskGroup(arg, getLayout(type, true, [this](Workflow::TaskLayout &layout) {
+                    layout.add([problemName = this->problemName]() -> std::unique_ptr<Workflow::Task> {
+                        auto ptr = std::make_unique<IntegratedGenerator>();
+                        ptr->setProblemName(problemName);
+                        return ptr;
+                    });
+                }));
+            };
+
+            addTaskGroup(type, factory, std::move(arg), memory);
+        }
+
+        template <typename IntegratedGenerator>
+        void add(std::shared_ptr<Variable::ArgumentList> arguments, const MemoryEstimate &memory = MemoryEstimate()) {
+            addSource(std::move(arguments), [this, memory](std::shared_ptr<Variable::Argument> arg) {
+                add<IntegratedGenerator>(std::move(arg), memory);
+            });
+        }
+
+        template <typename IntegratedGenerator>
+        void define(const std::string &name, const MemoryEstimate &memory = MemoryEstimate()) {
+            addDefinition(name, [this, memory](std::shared_ptr<Variable::Argument> arg) {
+                add<IntegratedGenerator>(std::move(arg), memory);
+            });
+        }
+    };
+
+    /**
+     * @brief A template which checks several candidate solutions against the
+     * standard solution. Every candidate runs and gets checked as soon as the
+     * standard answer exists, in parallel with the other candidates.
+     * 
+     */
+    class CheckingTemplate : public Template {
+    public:
+        CheckingTemplate(const std::string &problemName) :
+            Template(problemName),
+            report(std::make_shared<Report<CheckResult>>()) {}
+
+        template <typename Generator, typename Solution, typename Checker, typename ...Candidates>
+        void add(std::shared_ptr<Variable::Argument> arg, const MemoryEstimate &memory = MemoryEstimate()) {
+            static_assert(std::is_base_of_v<SolutionTask, Solution>,
+                "Solution must be a derived class of SolutionTask");
+            static_assert(std::is_base_of_v<CheckerTask, Checker>,
+                "Checker must be a derived class of CheckerTask");
+            static_assert((std::is_base_of_v<SolutionTask, Candidates> && ...),
+                "Candidates must be derived classes of SolutionTask");
+
+            static const std::string type = getTypeName<Generator, Solution, Checker, Candidates...>("CheckingTemplate");
+
+            auto factory = [this](std::shared_ptr<Variable::Argument> arg) {
+                prepareParameters<Generator, Solution, Checker, Candidates...>(*arg);
+                return Workflow::TaskGroup(arg, getLayout(type, true, [this](Workflow::TaskLayout &layout) {
+                    addGeneration<Generator, void>(layout);
+                    layout.add([problemName = this->problemName]() -> std::unique_ptr<Workflow::Task> {
+                        auto ptr = std::make_unique<Solution>();
+                        ptr->setProblemName(problemName);
+                        return ptr;
+                    });
+                    addCandidates<Checker, Candidates...>(layout, std::index_sequence_for<Candidates...>());
+                }));
+            };
+
+            addSolution(arg, [this]() -> std::unique_ptr<SolutionTask> {
+                auto ptr = std::make_unique<Solution>();
                 ptr->setProblemName(problemName);
                 return ptr;
             });
-            addTaskGroup(std::move(group));
+            addTaskGroup(type, factory, std::move(arg), memory);
+        }
+
+        template <typename Generator, typename Solution, typename Checker, typename ...Candidates>
+        void add(std::shared_ptr<Variable::ArgumentList> arguments, const MemoryEstimate &memory = MemoryEstimate()) {
+            addSource(std::move(arguments), [this, memory](std::shared_ptr<Variable::Argument> arg) {
+                add<Generator, Solution, Checker, Candidates...>(std::move(arg), memory);
+            });
+        }
+
+        template <typename Generator, typename Solution, typename Checker, typename ...Candidates>
+        void define(const std::string &name, const MemoryEstimate &memory = MemoryEstimate()) {
+            addDefinition(name, [this, memory](std::shared_ptr<Variable::Argument> arg) {
+                add<Generator, Solution, Checker, Candidates...>(std::move(arg), memory);
+            });
+        }
+
+        /**
+         * @brief Get the results of all checks. Call it after execute().
+         * 
+         * @return the report
+         */
+        const Report<CheckResult> &getReport() const {
+            return *report;
+        }
+
+        /**
+         * @brief Get the extension of the output file of a candidate.
+         * 
+         * @param candidate the index of the candidate in the template arguments
+         * @return the extension
+         */
+        static std::string getOutputExtension(int candidate) {
+            return ".candidate" + std::to_string(candidate) + ".out";
+        }
+    private:
+        std::shared_ptr<Report<CheckResult>> report;
+
+        /**
+         * @brief Add all candidates as a parallel stage.
+         * 
+         */
+        template <typename Checker, typename ...Candidates, std::size_t ...Index>
+        void addCandidates(Workflow::TaskLayout &layout, std::index_sequence<Index...>) {
+            layout.addParallel({ candidate<Checker, Candidates>(static_cast<int>(Index))... });
+        }
+
+        /**
+         * @brief Create a task which runs a candidate and then checks its output.
+         * 
+         */
+        template <typename Checker, typename Candidate>
+        std::function<std::unique_ptr<Workflow::Task>()> candidate(int index) {
+            return [problemName = this->problemName, report = this->report, index]()
+                -> std::unique_ptr<Workflow::Task> {
+                auto solution = std::make_unique<Candidate>();
+                solution->setProblemName(problemName);
+                solution->setOutputExtension(getOutputExtension(index));
+
+                auto checker = std::make_unique<Checker>();
+                checker->setProblemName(problemName);
+                checker->setCandidate(index, getOutputExtension(index));
+                checker->setReport(report);
+
+                auto ptr = std::make_unique<Workflow::TaskSequence>();
+                ptr->add(std::move(solution));
+                ptr->add(std::move(checker));
+                return ptr;
+            };
         }
     };
 } // namespace MultiGenerator::Interface
\ No newline at end of file
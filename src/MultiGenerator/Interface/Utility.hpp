@@ -11,6 +11,8 @@
 #pragma once
 
 #include <string>
+#include <functional>
+#include <type_traits>
 
 #include <MultiGenerator/Variable/Argument.hpp>
 
@@ -36,7 +38,7 @@ namespace MultiGenerator::Interface {
      * @return std::shared_ptr<Variable::Argument> the instance
      */
     inline std::shared_ptr<Variable::Argument> testcase(int id,
-        const std::unordered_map<std::string, std::string> &config) {
+        const Variable::DataConfig &config) {
         return std::make_shared<Variable::NormalArgument>(id, config);
     }
 
@@ -49,7 +51,42 @@ namespace MultiGenerator::Interface {
      * @return std::shared_ptr<Variable::Argument> the instance
      */
     inline std::shared_ptr<Variable::Argument> testcase(int subtaskId, int id,
-        const std::unordered_map<std::string, std::string> &config) {
+        const Variable::DataConfig &config) {
         return std::make_shared<Variable::SubtaskArgument>(subtaskId, id, config);
     }
+
+    /**
+     * @brief The estimated peak memory of a test case in bytes, given directly
+     * or computed from its config.
+     * 
+     */
+    class MemoryEstimate {
+    public:
+        using Estimator = std::function<std::size_t(const Variable::DataConfig &)>;
+
+        MemoryEstimate() :
+            estimator() {}
+
+        MemoryEstimate(std::size_t bytes) :
+            estimator([bytes](const Variable::DataConfig &) { return bytes; }) {}
+
+        template <typename Function, typename = std::enable_if_t<
+            std::is_invocable_r_v<std::size_t, Function, const Variable::DataConfig &>>>
+        MemoryEstimate(Function estimator) :
+            estimator(std::move(estimator)) {}
+
+        ~MemoryEstimate() {}
+
+        /**
+         * @brief Get the estimate of a test case.
+         * 
+         * @param config the config of the test case
+         * @return the memory in bytes, or 0 if unknown
+         */
+        std::size_t operator()(const Variable::DataConfig &config) const {
+            return (estimator ? estimator(config) : 0);
+        }
+    private:
+        Estimator estimator;
+    };
 } // namespace MultiGenerator::Interface
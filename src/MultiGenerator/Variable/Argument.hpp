@@ -14,10 +14,42 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <optional>
+#include <mutex>
+#include <atomic>
+#include <utility>
+#include <typeindex>
+#include <exception>
 
 #include <MultiGenerator/Variable/DataConfig.hpp>
+#include <MultiGenerator/Variable/Schema.hpp>
 
 namespace MultiGenerator::Variable {
+    class ArgumentIDInvalidException : public std::exception {
+    public:
+        ArgumentIDInvalidException(const std::string &id) :
+            msg("ArgumentIDInvalidException: Can't create an argument from ID: " + id) {}
+
+        const char *what() const noexcept override {
+            return msg.c_str();
+        }
+    private:
+        std::string msg;
+    };
+
+    class ParametersNotPreparedException : public std::exception {
+    public:
+        ParametersNotPreparedException(const std::string &id) :
+            msg("ParametersNotPreparedException: The parameters of test case " + id
+                + " aren't prepared before the execution.") {}
+
+        const char *what() const noexcept override {
+            return msg.c_str();
+        }
+    private:
+        std::string msg;
+    };
+
     /**
      * @brief A abstract class / interface descibing a test case including test
      * case ID & its configure.
@@ -25,10 +57,15 @@ namespace MultiGenerator::Variable {
      */
     class Argument {
     public:
-        Argument() : config() {}
+        Argument() :
+            config(),
+            parameters(),
+            sharedInputs() {}
 
         Argument(const DataConfig &config) :
-            config(config) {}
+            config(config),
+            parameters(),
+            sharedInputs() {}
 
         virtual ~Argument() {};
 
@@ -54,8 +91,128 @@ namespace MultiGenerator::Variable {
         const DataConfig &getConfig() const {
             return config;
         }
+
+        /**
+         * @brief Convert the config to typed parameters and keep them. Call it
+         * on one thread before the tasks run, so the config is checked early.
+         *
+         * @tparam Parameters the struct of parameters with a schema
+         * @return the parameters
+         * @throw SchemaException if the config doesn't match the schema
+         */
+        template <typename Parameters>
+        const Parameters &prepareParameters() {
+            if (auto res = findParameters<Parameters>())
+                return *res;
+
+            auto res = std::make_shared<const Parameters>(Variable::parseParameters<Parameters>(config));
+            parameters.emplace_back(std::type_index(typeid(Parameters)), res);
+            return *res;
+        }
+
+        /**
+         * @brief Get the parameters converted by prepareParameters().
+         *
+         * @tparam Parameters the struct of parameters
+         * @return the parameters
+         */
+        template <typename Parameters>
+        const Parameters &getParameters() const {
+            if (auto res = findParameters<Parameters>())
+                return *res;
+
+            throw ParametersNotPreparedException(getID());
+        }
+
+        /**
+         * @brief Get the input data parsed by parse, which is shared by all
+         * tasks of the test case. parse is called only once even if several
+         * tasks ask for the input at the same time, and the others wait for it.
+         *
+         * @tparam Input the type of the parsed input
+         * @param parse the function returning the parsed input
+         * @return the parsed input, kept until the last task holding it finishes
+         * and releaseSharedInputs() is called
+         */
+        template <typename Input, typename Parse>
+        std::shared_ptr<const Input> getSharedInput(Parse parse) const {
+            auto inputs = std::atomic_load(&sharedInputs);
+
+            if (!inputs) {
+                auto created = std::make_shared<SharedInputs>();
+                /** Another task may create them first. */
+                if (std::atomic_compare_exchange_strong(&sharedInputs, &inputs, created))
+                    inputs = std::move(created);
+            }
+
+            std::lock_guard<std::mutex> lock(inputs->mtx);
+
+            for (const auto &[type, value] : inputs->values) {
+                if (type == std::type_index(typeid(Input)))
+                    return std::static_pointer_cast<const Input>(value);
+            }
+
+            std::shared_ptr<const Input> res = std::make_shared<const Input>(parse());
+            inputs->values.emplace_back(std::type_index(typeid(Input)), res);
+            return res;
+        }
+
+        /**
+         * @brief Get the shared input of type Input without parsing it.
+         *
+         * @tparam Input the type of the parsed input
+         * @return the input, or nullptr if no task has parsed or generated it
+         */
+        template <typename Input>
+        std::shared_ptr<const Input> findSharedInput() const {
+            auto inputs = std::atomic_load(&sharedInputs);
+
+            if (!inputs)
+                return nullptr;
+
+            std::lock_guard<std::mutex> lock(inputs->mtx);
+
+            for (const auto &[type, value] : inputs->values) {
+                if (type == std::type_index(typeid(Input)))
+                    return std::static_pointer_cast<const Input>(value);
+            }
+
+            return nullptr;
+        }
+
+        /**
+         * @brief Drop the shared inputs. It's called when all tasks of the test
+         * case have finished, so that the inputs are freed.
+         *
+         */
+        void releaseSharedInputs() const {
+            std::atomic_store(&sharedInputs, std::shared_ptr<SharedInputs>());
+        }
     private:
+        struct SharedInputs {
+            std::mutex mtx;
+            std::vector<std::pair<std::type_index, std::shared_ptr<const void>>> values;
+        };
+
         DataConfig config;
+        /**
+         * The parameters of every type prepared, usually only one or two. They
+         * live on the heap, so a reference to them stays valid when more are
+         * prepared.
+         */
+        std::vector<std::pair<std::type_index, std::shared_ptr<const void>>> parameters;
+        /** The parsed inputs, created by the first task asking for one. */
+        mutable std::shared_ptr<SharedInputs> sharedInputs;
+
+        template <typename Parameters>
+        const Parameters *findParameters() const {
+            for (const auto &[type, value] : parameters) {
+                if (type == std::type_index(typeid(Parameters)))
+                    return static_cast<const Parameters *>(value.get());
+            }
+
+            return nullptr;
+        }
     };
 
     /**
@@ -110,6 +267,10 @@ namespace MultiGenerator::Variable {
         std::string getUninitializedID() const override {
             return std::string("-1--1");
         }
+
+        int getSubtask() const {
+            return subtask;
+        }
     private:
         int subtask;
         int id;
@@ -124,14 +285,14 @@ namespace MultiGenerator::Variable {
         ArgumentList() :
             args() {}
 
-        ~ArgumentList() {}
+        virtual ~ArgumentList() {}
 
         /**
          * @brief Return an Argument and remove it from the list.
          *
-         * @return a std::shared_ptr of the Argument
+         * @return a std::shared_ptr of the Argument, or std::nullopt if the list is empty
          */
-        std::optional<std::shared_ptr<Argument>> next() {
+        virtual std::optional<std::shared_ptr<Argument>> next() {
             if (args.empty())
                 return std::nullopt;
 
@@ -187,4 +348,33 @@ namespace MultiGenerator::Variable {
             args.push_back(std::make_shared<SubtaskArgument>(subtask, id, config));
         }
     };
+
+    /**
+     * @brief Create an Argument from the ID returned by getID(). It's the
+     * inverse of getID() for NormalArgument and SubtaskArgument.
+     *
+     * @param id the ID, e.g. "3" or "1-3"
+     * @param config the data config
+     * @return a std::shared_ptr of the Argument
+     */
+    inline std::shared_ptr<Argument> parseArgument(const std::string &id,
+        const DataConfig &config = DataConfig()) {
+        try {
+            std::size_t pos = 0;
+            int first = std::stoi(id, &pos);
+
+            if (pos == id.size())
+                return std::make_shared<NormalArgument>(first, config);
+
+            if (id[pos] == '-') {
+                std::size_t rest = 0;
+                int second = std::stoi(id.substr(pos + 1), &rest);
+
+                if (pos + 1 + rest == id.size())
+                    return std::make_shared<SubtaskArgument>(first, second, config);
+            }
+        } catch (const std::logic_error &) {}
+
+        throw ArgumentIDInvalidException(id);
+    }
 } // namespace MultiGenerator::Variable
\ No newline at end of file
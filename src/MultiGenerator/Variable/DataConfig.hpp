@@ -12,20 +12,62 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <utility>
+#include <algorithm>
+#include <iterator>
 #include <unordered_map>
+#include <unordered_set>
+#include <initializer_list>
 #include <optional>
 
 namespace MultiGenerator::Variable {
     /**
-     * @brief A simple object to store some configure for a test case.
+     * @brief A simple object to store some configure for a test case. The pairs
+     * are kept in a vector sorted by the keys, and every key is interned, so
+     * that it's stored once for all configs. Copies share the pairs until one
+     * of them is changed, so the test cases made from a common config cost
+     * little memory. Change a config before it's shared with other threads,
+     * e.g. before its test case is added to a template: the copy on write
+     * can't tell whether another thread is copying the same config.
      *
      */
     class DataConfig {
     public:
-        DataConfig() : config() {}
+        DataConfig() : entries() {}
 
         DataConfig(const std::unordered_map<std::string, std::string> &config) :
-            config(config) {}
+            entries() {
+            Entries res;
+            res.reserve(config.size());
+
+            for (const auto &[key, value] : config)
+                res.push_back({ intern(key), value });
+
+            std::sort(res.begin(), res.end(), compare);
+            entries = std::make_shared<Entries>(std::move(res));
+        }
+
+        /**
+         * @brief Create a config from some pairs. A key appearing more than once
+         * takes its first value, the same as insert().
+         *
+         * @param config the pairs
+         */
+        DataConfig(std::initializer_list<std::pair<std::string, std::string>> config) :
+            entries(createEntries(config.begin(), config.end())) {}
+
+        /**
+         * @brief Same as the above, but the pairs are in a std::vector.
+         *
+         * @param config the pairs
+         */
+        DataConfig(const std::vector<std::pair<std::string, std::string>> &config) :
+            entries(createEntries(config.begin(), config.end())) {}
 
         ~DataConfig() {};
 
@@ -37,10 +79,12 @@ namespace MultiGenerator::Variable {
          * @return false key already exists, true otherwise
          */
         bool insert(const std::string &key, const std::string &value) {
-            if (config.find(key) != config.end())
+            if (find(key) != nullptr)
                 return false;
 
-            config.insert({ key, value });
+            auto &res = getMutableEntries();
+            auto it = std::lower_bound(res.begin(), res.end(), key, compareKey);
+            res.insert(it, { intern(key), value });
             return true;
         }
 
@@ -51,7 +95,16 @@ namespace MultiGenerator::Variable {
          * @param newValue the new value
          */
         void change(const std::string &key, const std::string &newValue) {
-            config[key] = newValue;
+            if (auto value = find(key); value != nullptr && *value == newValue)
+                return;
+
+            auto &res = getMutableEntries();
+            auto it = std::lower_bound(res.begin(), res.end(), key, compareKey);
+
+            if (it != res.end() && *it->key == key)
+                it->value = newValue;
+            else
+                res.insert(it, { intern(key), newValue });
         }
 
         /**
@@ -61,12 +114,12 @@ namespace MultiGenerator::Variable {
          * @return false if key doesn't exist, true otherwise
          */
         bool erase(const std::string &key) {
-            if (auto it = config.find(key); it == config.end()) {
+            if (find(key) == nullptr)
                 return false;
-            } else {
-                config.erase(it);
-                return true;
-            }
+
+            auto &res = getMutableEntries();
+            res.erase(std::lower_bound(res.begin(), res.end(), key, compareKey));
+            return true;
         }
 
         /**
@@ -76,7 +129,7 @@ namespace MultiGenerator::Variable {
          * @return true or false
          */
         bool contain(const std::string &key) const {
-            return config.find(key) != config.end();
+            return find(key) != nullptr;
         }
 
         /**
@@ -86,10 +139,10 @@ namespace MultiGenerator::Variable {
          * @return the std::optional wrapper of the value or std::nullopt if key doesn' exists
          */
         std::optional<std::string> get(const std::string &key) const {
-            if (auto it = config.find(key); it == config.end())
+            if (auto value = find(key); value == nullptr)
                 return std::nullopt;
             else
-                return it->second;
+                return *value;
         }
 
         /**
@@ -100,16 +153,142 @@ namespace MultiGenerator::Variable {
          * @return std::string or the default value
          */
         std::string getOr(const std::string &key, const std::string defaultValue) const {
-            if (auto it = config.find(key); it == config.end())
+            if (auto value = find(key); value == nullptr)
                 return defaultValue;
             else
-                return it->second;
+                return *value;
+        }
+
+        /**
+         * @brief Get the number of pairs.
+         *
+         * @return the number
+         */
+        std::size_t size() const {
+            return (entries ? entries->size() : 0);
+        }
+
+        /**
+         * @brief Check whether two configs share their pairs, i.e. one is copied
+         * from the other and neither is changed since.
+         *
+         * @param other the other config
+         * @return true or false
+         */
+        bool isSharedWith(const DataConfig &other) const {
+            return entries != nullptr && entries == other.entries;
+        }
+
+        /**
+         * @brief Visit every pair (key, value) in the order of the keys.
+         *
+         * @tparam Function the type of the visitor
+         * @param function the visitor called with the key and the value
+         */
+        template <typename Function>
+        void forEach(Function function) const {
+            if (!entries)
+                return;
+
+            for (const auto &entry : *entries)
+                function(*entry.key, entry.value);
         }
 
         static DataConfig create(const std::unordered_map<std::string, std::string> &config) {
             return DataConfig(config);
         }
     private:
-        std::unordered_map<std::string, std::string> config;
+        struct Entry {
+            /** The interned key, which lives as long as the program. */
+            const std::string *key;
+            std::string value;
+        };
+
+        using Entries = std::vector<Entry>;
+
+        std::shared_ptr<Entries> entries;
+
+        const std::string *find(const std::string &key) const {
+            if (!entries)
+                return nullptr;
+
+            auto it = std::lower_bound(entries->begin(), entries->end(), key, compareKey);
+            return (it != entries->end() && *it->key == key ? &it->value : nullptr);
+        }
+
+        /**
+         * @brief Get the pairs to be changed, which are copied first if they're
+         * shared with other configs. use_count() is only exact while no other
+         * thread copies this config, which is why a config mustn't be changed
+         * after it's shared between threads.
+         *
+         * @return the pairs
+         */
+        Entries &getMutableEntries() {
+            if (!entries || entries.use_count() > 1)
+                entries = std::make_shared<Entries>(entries ? *entries : Entries());
+
+            return *entries;
+        }
+
+        /**
+         * @brief Create the sorted pairs from some pairs. A key appearing more
+         * than once takes its first value.
+         *
+         */
+        template <typename Iterator>
+        static std::shared_ptr<Entries> createEntries(Iterator first, Iterator last) {
+            Entries res;
+            res.reserve(static_cast<std::size_t>(std::distance(first, last)));
+
+            for (auto it = first; it != last; ++it)
+                res.push_back({ intern(it->first), it->second });
+
+            std::stable_sort(res.begin(), res.end(), compare);
+            res.erase(std::unique(res.begin(), res.end(), [](const Entry &lhs, const Entry &rhs) {
+                return lhs.key == rhs.key;
+            }), res.end());
+            return std::make_shared<Entries>(std::move(res));
+        }
+
+        static bool compare(const Entry &lhs, const Entry &rhs) {
+            return *lhs.key < *rhs.key;
+        }
+
+        static bool compareKey(const Entry &entry, const std::string &key) {
+            return *entry.key < key;
+        }
+
+        /**
+         * @brief Get the interned copy of a key. Every thread remembers the keys
+         * it has seen, so that only a key new to the thread takes the lock. The
+         * nodes of the set never move, so the views into them stay valid.
+         *
+         */
+        static const std::string *intern(const std::string &key) {
+            static std::shared_mutex mtx;
+            static std::unordered_set<std::string> keys;
+            thread_local std::unordered_map<std::string_view, const std::string *> cache;
+
+            if (auto it = cache.find(key); it != cache.end())
+                return it->second;
+
+            const std::string *res = nullptr;
+
+            {
+                std::shared_lock<std::shared_mutex> lock(mtx);
+
+                if (auto it = keys.find(key); it != keys.end())
+                    res = &*it;
+            }
+
+            if (res == nullptr) {
+                std::lock_guard<std::shared_mutex> lock(mtx);
+                res = &*keys.insert(key).first;
+            }
+
+            cache.emplace(*res, res);
+            return res;
+        }
     };
 } // namespace MultiGenerator::Variable
\ No newline at end of file
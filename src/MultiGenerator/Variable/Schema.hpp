@@ -0,0 +1,197 @@
+/**
+ * @file MultiGenerator/Variable/Schema.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief This file contains Schema which converts a DataConfig to a typed
+ * struct of parameters once, so that tasks don't look up or parse strings.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <type_traits>
+#include <charconv>
+#include <cstdlib>
+#include <cerrno>
+#include <exception>
+
+#include <MultiGenerator/Variable/DataConfig.hpp>
+
+namespace MultiGenerator::Variable {
+    class SchemaException : public std::exception {
+    public:
+        SchemaException(const std::string &key, const std::string &reason) :
+            msg("SchemaException: The key \"" + key + "\" " + reason) {}
+
+        const char *what() const noexcept override {
+            return msg.c_str();
+        }
+    private:
+        std::string msg;
+    };
+
+    /**
+     * @brief The conversion from the string in a DataConfig to a value.
+     * Specialize it to use other types in a Schema.
+     *
+     * @tparam Value the type of the value
+     */
+    template <typename Value, typename = void>
+    struct ParameterParser {
+        static_assert(!std::is_same_v<Value, Value>, "There is no ParameterParser for the type");
+    };
+
+    template <typename Value>
+    struct ParameterParser<Value, std::enable_if_t<std::is_integral_v<Value> && !std::is_same_v<Value, bool>>> {
+        static bool parse(const std::string &str, Value &value) {
+            auto [end, error] = std::from_chars(str.data(), str.data() + str.size(), value);
+            return error == std::errc() && end == str.data() + str.size();
+        }
+    };
+
+    template <typename Value>
+    struct ParameterParser<Value, std::enable_if_t<std::is_floating_point_v<Value>>> {
+        static bool parse(const std::string &str, Value &value) {
+            char *end = nullptr;
+            errno = 0;
+            long double res = std::strtold(str.c_str(), &end);
+
+            if (str.empty() || errno != 0 || end != str.c_str() + str.size())
+                return false;
+
+            value = static_cast<Value>(res);
+            return true;
+        }
+    };
+
+    template <>
+    struct ParameterParser<bool> {
+        static bool parse(const std::string &str, bool &value) {
+            if (str == "true" || str == "1")
+                value = true;
+            else if (str == "false" || str == "0")
+                value = false;
+            else
+                return false;
+
+            return true;
+        }
+    };
+
+    template <>
+    struct ParameterParser<std::string> {
+        static bool parse(const std::string &str, std::string &value) {
+            value = str;
+            return true;
+        }
+    };
+
+    /**
+     * @brief The description of the fields of a struct of parameters, i.e. the
+     * key, the member and whether it's required. Parameters declares its schema
+     * by a static function getSchema(), e.g.
+     *
+     *     struct AddParameters {
+     *         int a;
+     *         long long b;
+     *
+     *         static Schema<AddParameters> getSchema() {
+     *             Schema<AddParameters> schema;
+     *             schema.required("a", &AddParameters::a);
+     *             schema.optional("b", &AddParameters::b, 0LL);
+     *             return schema;
+     *         }
+     *     };
+     *
+     * @tparam Parameters the struct of parameters, which is default constructible
+     */
+    template <typename Parameters>
+    class Schema {
+    public:
+        Schema() :
+            fields() {}
+
+        ~Schema() {}
+
+        /**
+         * @brief Add a field which must exist in the config.
+         *
+         * @param key the key in the config
+         * @param member the member of Parameters
+         * @return this schema
+         */
+        template <typename Value>
+        Schema &required(const std::string &key, Value Parameters::*member) {
+            fields.push_back([key, member](Parameters &parameters, const DataConfig &config) {
+                auto value = config.get(key);
+
+                if (!value.has_value())
+                    throw SchemaException(key, "is missing.");
+
+                convert(key, value.value(), parameters.*member);
+            });
+            return *this;
+        }
+
+        /**
+         * @brief Add a field which takes the default value if the key doesn't exist.
+         *
+         * @param key the key in the config
+         * @param member the member of Parameters
+         * @param defaultValue the default value
+         * @return this schema
+         */
+        template <typename Value>
+        Schema &optional(const std::string &key, Value Parameters::*member, Value defaultValue) {
+            fields.push_back([key, member, defaultValue](Parameters &parameters, const DataConfig &config) {
+                if (auto value = config.get(key); value.has_value())
+                    convert(key, value.value(), parameters.*member);
+                else
+                    parameters.*member = defaultValue;
+            });
+            return *this;
+        }
+
+        /**
+         * @brief Convert a config to the parameters.
+         *
+         * @param config the config
+         * @return the parameters
+         * @throw SchemaException if a required key is missing or a value is invalid
+         */
+        Parameters parse(const DataConfig &config) const {
+            Parameters res{};
+
+            for (const auto &field : fields)
+                field(res, config);
+
+            return res;
+        }
+    private:
+        std::vector<std::function<void(Parameters &, const DataConfig &)>> fields;
+
+        template <typename Value>
+        static void convert(const std::string &key, const std::string &str, Value &value) {
+            if (!ParameterParser<Value>::parse(str, value))
+                throw SchemaException(key, "has an invalid value \"" + str + "\".");
+        }
+    };
+
+    /**
+     * @brief Convert a config to the parameters by Parameters::getSchema().
+     *
+     * @tparam Parameters the struct of parameters
+     * @param config the config
+     * @return the parameters
+     */
+    template <typename Parameters>
+    Parameters parseParameters(const DataConfig &config) {
+        static const Schema<Parameters> schema = Parameters::getSchema();
+        return schema.parse(config);
+    }
+} // namespace MultiGenerator::Variable
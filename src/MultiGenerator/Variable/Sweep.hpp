@@ -0,0 +1,315 @@
+/**
+ * @file MultiGenerator/Variable/Sweep.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief This file contains the parameter sweeps over the keys of DataConfig
+ * and a lazy ArgumentList creating one test case for every point of a sweep.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <optional>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <exception>
+
+#include <MultiGenerator/Variable/DataConfig.hpp>
+#include <MultiGenerator/Variable/Argument.hpp>
+
+namespace MultiGenerator::Variable {
+    class SweepInvalidException : public std::exception {
+    public:
+        SweepInvalidException(const std::string &reason) :
+            msg("SweepInvalidException: " + reason) {}
+
+        const char *what() const noexcept override {
+            return msg.c_str();
+        }
+    private:
+        std::string msg;
+    };
+
+    /**
+     * @brief A sequence of points, each of which gives the values of some keys.
+     * A point is computed from its index when it's needed, so a sweep of
+     * millions of points takes almost no memory.
+     *
+     */
+    class Sweep {
+    public:
+        using Point = std::vector<std::pair<std::string, std::string>>;
+
+        Sweep() {}
+
+        virtual ~Sweep() {}
+
+        virtual std::size_t size() const = 0;
+
+        /**
+         * @brief Append the pairs of a point to point.
+         *
+         * @param index the index of the point, less than size()
+         * @param point the pairs to append to
+         */
+        virtual void get(std::size_t index, Point &point) const = 0;
+    };
+
+    /**
+     * @brief A sweep over the given values of a key.
+     *
+     */
+    class ValueSweep : public Sweep {
+    public:
+        ValueSweep(const std::string &key, std::vector<std::string> values) :
+            Sweep(),
+            key(key),
+            values(std::move(values)) {}
+
+        ~ValueSweep() {}
+
+        std::size_t size() const override {
+            return values.size();
+        }
+
+        void get(std::size_t index, Point &point) const override {
+            point.emplace_back(key, values[index]);
+        }
+    private:
+        std::string key;
+        std::vector<std::string> values;
+    };
+
+    /**
+     * @brief A sweep over first, first + step, ... of a key, up to last.
+     *
+     */
+    class RangeSweep : public Sweep {
+    public:
+        RangeSweep(const std::string &key, long long first, long long last, long long step = 1) :
+            Sweep(),
+            key(key),
+            first(first),
+            step(step),
+            count(0) {
+            if (step == 0)
+                throw SweepInvalidException("The step of a range is 0.");
+
+            if ((step > 0 && first <= last) || (step < 0 && first >= last))
+                count = static_cast<std::size_t>((last - first) / step) + 1;
+        }
+
+        ~RangeSweep() {}
+
+        std::size_t size() const override {
+            return count;
+        }
+
+        void get(std::size_t index, Point &point) const override {
+            point.emplace_back(key, std::to_string(first + static_cast<long long>(index) * step));
+        }
+    private:
+        std::string key;
+        long long first;
+        long long step;
+        std::size_t count;
+    };
+
+    /**
+     * @brief A sweep over first, first * ratio, first * ratio ^ 2, ... of a key,
+     * rounded to integers, up to last. A value equal to the previous one after
+     * rounding is skipped.
+     *
+     */
+    class GeometricSweep : public Sweep {
+    public:
+        GeometricSweep(const std::string &key, long long first, long long last, double ratio) :
+            Sweep(),
+            key(key),
+            values() {
+            if (first <= 0 || ratio <= 1)
+                throw SweepInvalidException("A geometric sweep needs first > 0 and ratio > 1.");
+
+            for (double value = static_cast<double>(first); value < static_cast<double>(last) + 0.5; value *= ratio) {
+                auto rounded = std::llround(value);
+
+                if (values.empty() || values.back() != rounded)
+                    values.push_back(rounded);
+            }
+        }
+
+        ~GeometricSweep() {}
+
+        std::size_t size() const override {
+            return values.size();
+        }
+
+        void get(std::size_t index, Point &point) const override {
+            point.emplace_back(key, std::to_string(values[index]));
+        }
+    private:
+        std::string key;
+        /** There are only logarithmically many values, so they're kept. */
+        std::vector<long long> values;
+    };
+
+    /**
+     * @brief The cartesian product of some sweeps. The last sweep changes the
+     * fastest.
+     *
+     */
+    class ProductSweep : public Sweep {
+    public:
+        ProductSweep(std::vector<std::shared_ptr<Sweep>> sweeps) :
+            Sweep(),
+            sweeps(std::move(sweeps)),
+            count(1) {
+            for (const auto &sweep : this->sweeps)
+                count *= sweep->size();
+        }
+
+        ~ProductSweep() {}
+
+        std::size_t size() const override {
+            return (sweeps.empty() ? 0 : count);
+        }
+
+        void get(std::size_t index, Point &point) const override {
+            auto begin = point.size();
+
+            for (auto it = sweeps.rbegin(); it != sweeps.rend(); ++it) {
+                auto size = (*it)->size();
+                (*it)->get(index % size, point);
+                index /= size;
+            }
+            /** Keep the pairs in the order of the sweeps. */
+            std::reverse(point.begin() + static_cast<long>(begin), point.end());
+        }
+    private:
+        std::vector<std::shared_ptr<Sweep>> sweeps;
+        std::size_t count;
+    };
+
+    /**
+     * @brief count points chosen uniformly at random from another sweep, with
+     * replacement. The same seed always gives the same points.
+     *
+     */
+    class SampleSweep : public Sweep {
+    public:
+        SampleSweep(std::shared_ptr<Sweep> sweep, std::size_t count, std::uint64_t seed) :
+            Sweep(),
+            sweep(std::move(sweep)),
+            count(count),
+            seed(seed) {}
+
+        ~SampleSweep() {}
+
+        std::size_t size() const override {
+            return (sweep->size() == 0 ? 0 : count);
+        }
+
+        void get(std::size_t index, Point &point) const override {
+            sweep->get(static_cast<std::size_t>(mix(seed + index) % sweep->size()), point);
+        }
+    private:
+        std::shared_ptr<Sweep> sweep;
+        std::size_t count;
+        std::uint64_t seed;
+
+        /**
+         * @brief The SplitMix64 finalizer, which maps consecutive indexes to
+         * unrelated values.
+         *
+         */
+        static std::uint64_t mix(std::uint64_t value) {
+            value += 0x9e3779b97f4a7c15ULL;
+            value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+            return value ^ (value >> 31);
+        }
+    };
+
+    /**
+     * @brief A list which creates an Argument for every point of a sweep only
+     * when it's taken. The config of an Argument is a copy of base with the
+     * pairs of the point set.
+     *
+     */
+    class SweepArgumentList : public ArgumentList {
+    public:
+        /**
+         * @brief Create NormalArgument with the IDs from firstID.
+         *
+         * @param sweep the sweep
+         * @param base the config of the keys not in the sweep
+         * @param firstID the ID of the first test case
+         */
+        SweepArgumentList(std::shared_ptr<Sweep> sweep, const DataConfig &base = DataConfig(),
+            int firstID = 1) :
+            SweepArgumentList(-1, std::move(sweep), base, firstID) {}
+
+        /**
+         * @brief Create SubtaskArgument of subtask with the IDs from firstID.
+         *
+         * @param subtask the subtask ID
+         * @param sweep the sweep
+         * @param base the config of the keys not in the sweep
+         * @param firstID the ID of the first test case in the subtask
+         */
+        SweepArgumentList(int subtask, std::shared_ptr<Sweep> sweep, const DataConfig &base = DataConfig(),
+            int firstID = 1) :
+            ArgumentList(),
+            sweep(std::move(sweep)),
+            base(base),
+            subtask(subtask),
+            firstID(firstID),
+            index(0),
+            point() {}
+
+        ~SweepArgumentList() {}
+
+        std::optional<std::shared_ptr<Argument>> next() override {
+            if (index >= sweep->size())
+                return std::nullopt;
+
+            point.clear();
+            sweep->get(index, point);
+            DataConfig config = base;
+
+            for (const auto &[key, value] : point)
+                config.change(key, value);
+
+            int id = firstID + static_cast<int>(index++);
+
+            if (subtask < 0)
+                return std::make_shared<NormalArgument>(id, config);
+            else
+                return std::make_shared<SubtaskArgument>(subtask, id, config);
+        }
+
+        /**
+         * @brief Get how many Arguments haven't been taken.
+         *
+         * @return the count
+         */
+        std::size_t size() const {
+            return sweep->size() - index;
+        }
+    private:
+        std::shared_ptr<Sweep> sweep;
+        DataConfig base;
+        /** The subtask ID, or -1 for NormalArgument. */
+        int subtask;
+        int firstID;
+        std::size_t index;
+        Sweep::Point point;
+    };
+} // namespace MultiGenerator::Variable
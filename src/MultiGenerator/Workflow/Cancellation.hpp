@@ -0,0 +1,50 @@
+/**
+ * @file MultiGenerator/Workflow/Cancellation.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief A token which is used to cancel tasks that haven't started yet.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace MultiGenerator::Workflow {
+    /**
+     * @brief A token which is used to cancel tasks. All copies of a token share
+     * the same state.
+     *
+     * A default constructed token is empty: it allocates nothing, is never
+     * cancelled and ignores cancel(). Use create() for a token which can be
+     * cancelled.
+     *
+     */
+    class CancellationToken {
+    public:
+        CancellationToken() :
+            state() {}
+
+        ~CancellationToken() {}
+
+        static CancellationToken create() {
+            CancellationToken token;
+            token.state = std::make_shared<std::atomic_bool>(false);
+            return token;
+        }
+
+        void cancel() const {
+            if (state)
+                state->store(true, std::memory_order_release);
+        }
+
+        bool isCancelled() const {
+            return state && state->load(std::memory_order_acquire);
+        }
+    private:
+        std::shared_ptr<std::atomic_bool> state;
+    };
+} // namespace MultiGenerator::Workflow
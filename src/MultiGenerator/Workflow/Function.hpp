@@ -0,0 +1,154 @@
+/**
+ * @file MultiGenerator/Workflow/Function.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief A move-only function wrapper which stores small callable objects
+ * inside itself.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+namespace MultiGenerator::Workflow {
+    template <typename Signature, std::size_t Capacity = 48>
+    class SmallFunction;
+
+    /**
+     * @brief A move-only function wrapper like std::function. A callable object
+     * no larger than Capacity is stored in the wrapper without allocating, and a
+     * larger one is stored on the heap.
+     *
+     * @tparam Result the type of the returned value
+     * @tparam Args the type of the arguments
+     * @tparam Capacity the size of the inline buffer
+     */
+    template <typename Result, typename ...Args, std::size_t Capacity>
+    class SmallFunction<Result(Args...), Capacity> {
+    public:
+        SmallFunction() noexcept :
+            invoker(nullptr),
+            manager(nullptr) {}
+
+        template <typename Function, typename = std::enable_if_t<
+            !std::is_same_v<std::decay_t<Function>, SmallFunction>
+            && std::is_invocable_r_v<Result, std::decay_t<Function> &, Args...>>>
+        SmallFunction(Function &&function) :
+            invoker(nullptr),
+            manager(nullptr) {
+            using Decayed = std::decay_t<Function>;
+
+            if constexpr (isInline<Decayed>()) {
+                new (&storage) Decayed(std::forward<Function>(function));
+                invoker = &invokeInline<Decayed>;
+                manager = &manageInline<Decayed>;
+            } else {
+                new (&storage) Decayed *(new Decayed(std::forward<Function>(function)));
+                invoker = &invokeHeap<Decayed>;
+                manager = &manageHeap<Decayed>;
+            }
+        }
+
+        SmallFunction(const SmallFunction &) = delete;
+
+        SmallFunction(SmallFunction &&rhs) noexcept :
+            invoker(nullptr),
+            manager(nullptr) {
+            moveFrom(rhs);
+        }
+
+        SmallFunction &operator=(const SmallFunction &) = delete;
+
+        SmallFunction &operator=(SmallFunction &&rhs) noexcept {
+            if (this != &rhs) {
+                reset();
+                moveFrom(rhs);
+            }
+
+            return *this;
+        }
+
+        ~SmallFunction() {
+            reset();
+        }
+
+        explicit operator bool() const noexcept {
+            return invoker != nullptr;
+        }
+
+        Result operator()(Args ...args) {
+            return invoker(&storage, std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Destroy the stored callable object.
+         *
+         */
+        void reset() noexcept {
+            if (manager)
+                manager(&storage, nullptr);
+
+            invoker = nullptr;
+            manager = nullptr;
+        }
+    private:
+        using Invoker = Result (*)(void *, Args &&...);
+        /** Move the object from the second buffer to the first one, or destroy it if the second is nullptr. */
+        using Manager = void (*)(void *, void *);
+
+        alignas(std::max_align_t) unsigned char storage[Capacity];
+        Invoker invoker;
+        Manager manager;
+
+        template <typename Function>
+        static constexpr bool isInline() {
+            return sizeof(Function) <= Capacity && alignof(Function) <= alignof(std::max_align_t)
+                && std::is_nothrow_move_constructible_v<Function>;
+        }
+
+        template <typename Function>
+        static Result invokeInline(void *buffer, Args &&...args) {
+            return (*static_cast<Function *>(buffer))(std::forward<Args>(args)...);
+        }
+
+        template <typename Function>
+        static void manageInline(void *buffer, void *source) {
+            if (source) {
+                new (buffer) Function(std::move(*static_cast<Function *>(source)));
+                static_cast<Function *>(source)->~Function();
+            } else {
+                static_cast<Function *>(buffer)->~Function();
+            }
+        }
+
+        template <typename Function>
+        static Result invokeHeap(void *buffer, Args &&...args) {
+            return (**static_cast<Function **>(buffer))(std::forward<Args>(args)...);
+        }
+
+        template <typename Function>
+        static void manageHeap(void *buffer, void *source) {
+            if (source)
+                *static_cast<Function **>(buffer) = *static_cast<Function **>(source);
+            else
+                delete *static_cast<Function **>(buffer);
+        }
+
+        void moveFrom(SmallFunction &rhs) noexcept {
+            if (!rhs.manager)
+                return;
+
+            rhs.manager(&storage, &rhs.storage);
+            invoker = rhs.invoker;
+            manager = rhs.manager;
+            rhs.invoker = nullptr;
+            rhs.manager = nullptr;
+        }
+    };
+} // namespace MultiGenerator::Workflow
@@ -0,0 +1,84 @@
+/**
+ * @file MultiGenerator/Workflow/Registry.hpp
+ * @author Justin Chen (ctj12461@163.com)
+ * @brief A registry which creates task groups by the names of their types.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+
+#include <string>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <exception>
+
+#include <MultiGenerator/Variable/Argument.hpp>
+#include <MultiGenerator/Workflow/TaskGroup.hpp>
+
+namespace MultiGenerator::Workflow {
+    class TaskGroupTypeNotFoundException : public std::exception {
+    public:
+        TaskGroupTypeNotFoundException(const std::string &type) :
+            msg("TaskGroupTypeNotFoundException: Unknown type of task group: " + type) {}
+
+        const char *what() const noexcept override {
+            return msg.c_str();
+        }
+    private:
+        std::string msg;
+    };
+
+    /**
+     * @brief A registry which creates task groups by the names of their types,
+     * so that a group can be described by its type and its argument only.
+     *
+     */
+    class TaskGroupRegistry {
+    public:
+        using Factory = std::function<TaskGroup(std::shared_ptr<Variable::Argument>)>;
+
+        TaskGroupRegistry() :
+            factories() {}
+
+        ~TaskGroupRegistry() {}
+
+        /**
+         * @brief Register a type. Return false if type already exists.
+         *
+         * @param type the name of the type
+         * @param factory the function creating a group of this type
+         * @return false if type already exists, true otherwise
+         */
+        bool add(const std::string &type, Factory factory) {
+            return factories.emplace(type, std::move(factory)).second;
+        }
+
+        bool contain(const std::string &type) const {
+            return factories.find(type) != factories.end();
+        }
+
+        /**
+         * @brief Create a group of a registered type. Throw if type doesn't exist.
+         *
+         * @param type the name of the type
+         * @param arg the argument of the group
+         * @return the group
+         */
+        TaskGroup create(const std::string &type, std::shared_ptr<Variable::Argument> arg) const {
+            auto it = factories.find(type);
+
+            if (it == factories.end())
+                throw TaskGroupTypeNotFoundException(type);
+
+            auto group = it->second(std::move(arg));
+            group.setType(type);
+            return group;
+        }
+    private:
+        std::unordered_map<std::string, Factory> factories;
+    };
+} // namespace MultiGenerator::Workflow
\ No newline at end of file
@@ -12,7 +12,9 @@
 
 #include <atomic>
 #include <functional>
+#include <exception>
 
+#include <MultiGenerator/Context/Trace.hpp>
 #include <MultiGenerator/Workflow/Callable.hpp>
 
 namespace MultiGenerator::Workflow {
@@ -33,7 +35,9 @@ namespace MultiGenerator::Workflow {
         };
 
         Runner() :
-            status(Status::Pending) {}
+            status(Status::Pending),
+            exception(),
+            enqueueTime() {}
 
         virtual ~Runner() {}
 
@@ -48,13 +52,41 @@ namespace MultiGenerator::Workflow {
             if (!status.compare_exchange_strong(oldStatus, Status::Running))
                 return;
 
-            run();
+            /** Keep the exception instead of letting it kill the worker thread. */
+            try {
+                run();
+            } catch (...) {
+                exception = std::current_exception();
+            }
+
             status = Status::Finished;
         }
 
         Status getStatus() const {
             return status;
         }
+
+        /**
+         * @brief Get the exception thrown by run(), or nullptr if it returned
+         * normally. Check it after the runner has finished.
+         * 
+         */
+        std::exception_ptr getException() const {
+            return exception;
+        }
+
+        /**
+         * @brief Set when the runner is put into a queue, which is used to trace
+         * how long it waits. It's only set if the trace is on.
+         * 
+         */
+        void setEnqueueTime(Context::Trace::TimePoint enqueueTime) {
+            this->enqueueTime = enqueueTime;
+        }
+
+        Context::Trace::TimePoint getEnqueueTime() const {
+            return enqueueTime;
+        }
     protected:
         /**
          * @brief The runner will execute run(). Implement this function in
@@ -64,6 +96,8 @@ namespace MultiGenerator::Workflow {
         virtual void run() = 0;
     private:
         std::atomic<Status> status;
+        std::exception_ptr exception;
+        Context::Trace::TimePoint enqueueTime;
     };
 
     /**
@@ -102,7 +136,11 @@ namespace MultiGenerator::Workflow {
         std::unique_ptr<Callable> callable;
 
         void run() override {
-            callable = constructor();
+            {
+                MULTIGENERATOR_TRACE_SCOPE(scope, "construct", "task");
+                callable = constructor();
+            }
+
             callable->call();
         }
     };
@@ -11,11 +11,25 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <MultiGenerator/Workflow/Callable.hpp>
+#include <MultiGenerator/Workflow/Cancellation.hpp>
 #include <MultiGenerator/Variable/Argument.hpp>
 
 namespace MultiGenerator::Workflow {
+    /**
+     * @brief The resource which limits the speed of a task. The tasks of
+     * different classes are executed by different workers.
+     * 
+     */
+    enum class ResourceClass {
+        /** Mostly computing, such as solutions. */
+        CPU,
+        /** Mostly reading or writing files, such as generators. */
+        IO
+    };
+
     /**
      * @brief A abstract base class of all task classes.
      * 
@@ -23,14 +37,101 @@ namespace MultiGenerator::Workflow {
     class Task : public Callable {
     public:
         Task() :
-            arg() {}
+            arg(),
+            groupToken(),
+            runToken() {}
 
         ~Task() {}
 
         virtual void setArgument(std::shared_ptr<Variable::Argument> arg) {
             this->arg = std::move(arg);
         }
+
+        /**
+         * @brief Set the token of the TaskGroup this task belongs to. Cancel it
+         * to skip the remaining stages of the group.
+         * 
+         * @param groupToken the token of the group
+         */
+        virtual void setGroupToken(CancellationToken groupToken) {
+            this->groupToken = std::move(groupToken);
+        }
+
+        /**
+         * @brief Set the token of the whole run, which is cancelled when another
+         * group fails and the executor fails fast.
+         * 
+         * @param runToken the token of the run
+         */
+        virtual void setRunToken(CancellationToken runToken) {
+            this->runToken = std::move(runToken);
+        }
     protected:
         std::shared_ptr<Variable::Argument> arg;
+        CancellationToken groupToken;
+        CancellationToken runToken;
+
+        /**
+         * @brief Check whether the group or the whole run is cancelled, which lets
+         * a long task stop early.
+         * 
+         */
+        bool isCancelled() const {
+            return groupToken.isCancelled() || runToken.isCancelled();
+        }
+    };
+
+    /**
+     * @brief A task which executes some tasks one by one in the same runner.
+     * 
+     */
+    class TaskSequence : public Task {
+    public:
+        TaskSequence() :
+            Task(),
+            tasks() {}
+
+        ~TaskSequence() {}
+
+        /**
+         * @brief Append a task. Call it before setArgument().
+         * 
+         * @param task the task to append
+         */
+        void add(std::unique_ptr<Task> task) {
+            tasks.push_back(std::move(task));
+        }
+
+        void setArgument(std::shared_ptr<Variable::Argument> arg) override {
+            for (auto &task : tasks)
+                task->setArgument(arg);
+
+            Task::setArgument(std::move(arg));
+        }
+
+        void setGroupToken(CancellationToken groupToken) override {
+            for (auto &task : tasks)
+                task->setGroupToken(groupToken);
+
+            Task::setGroupToken(std::move(groupToken));
+        }
+
+        void setRunToken(CancellationToken runToken) override {
+            for (auto &task : tasks)
+                task->setRunToken(runToken);
+
+            Task::setRunToken(std::move(runToken));
+        }
+
+        void call() override {
+            for (auto &task : tasks) {
+                if (isCancelled())
+                    break;
+
+                task->call();
+            }
+        }
+    private:
+        std::vector<std::unique_ptr<Task>> tasks;
     };
 } // namespace MultiGenerator::Workflow
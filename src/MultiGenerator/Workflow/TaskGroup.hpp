@@ -14,81 +14,499 @@
 #include <functional>
 #include <vector>
 #include <optional>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <atomic>
 
 #include <MultiGenerator/Workflow/Task.hpp>
 
 namespace MultiGenerator::Workflow {
     /**
-     * @brief A structure which stores the task ID & its constructor.
+     * @brief A structure which stores the task ID, its constructor & its resource class.
      * 
      */
     struct TaskEntry {
         int id;
         std::function<std::unique_ptr<Task>()> constructor;
+        ResourceClass resourceClass;
 
-        TaskEntry(int id, std::function<std::unique_ptr<Task>()> constructor) :
+        TaskEntry(int id, std::function<std::unique_ptr<Task>()> constructor,
+            ResourceClass resourceClass = ResourceClass::CPU) :
             id(id),
-            constructor(std::move(constructor)) {}
+            constructor(std::move(constructor)),
+            resourceClass(resourceClass) {}
 
         ~TaskEntry() {}
     };
 
     /**
-     * @brief A class which stores a group of tasks.
+     * @brief The tasks and the stages of a TaskGroup without its argument, so
+     * that it can be shared by all groups of the same type. A task gets the
+     * argument and the token of its group when it's created by the group.
+     * 
+     */
+    class TaskLayout {
+    public:
+        TaskLayout() :
+            entry(),
+            stageEnd(),
+            type() {}
+
+        ~TaskLayout() {}
+
+        /**
+         * @brief Add a task as a new stage. It starts after all tasks added
+         * before have finished.
+         * 
+         * @param constructor the constructor of the task
+         * @param resourceClass the resource which limits the task
+         * @return the id of this task
+         */
+        int add(std::function<std::unique_ptr<Task>()> constructor,
+            ResourceClass resourceClass = ResourceClass::CPU) {
+            stageEnd.push_back(static_cast<int>(entry.size()) + 1);
+            return addEntry(std::move(constructor), resourceClass);
+        }
+
+        /**
+         * @brief Add some tasks as a new stage. They start together after all
+         * tasks added before have finished and may run at the same time.
+         * 
+         * @param constructors the constructors of the tasks
+         * @param resourceClass the resource which limits the tasks
+         * @return the ids of these tasks
+         */
+        std::vector<int> addParallel(std::vector<std::function<std::unique_ptr<Task>()>> constructors,
+            ResourceClass resourceClass = ResourceClass::CPU) {
+            std::vector<std::pair<std::function<std::unique_ptr<Task>()>, ResourceClass>> tasks;
+
+            for (auto &constructor : constructors)
+                tasks.emplace_back(std::move(constructor), resourceClass);
+
+            return addParallel(std::move(tasks));
+        }
+
+        /**
+         * @brief Same as the above, but every task has its own resource class,
+         * e.g. a solution using the CPU and a task writing a file.
+         * 
+         * @param tasks the constructors and the resource classes of the tasks
+         * @return the ids of these tasks
+         */
+        std::vector<int> addParallel(std::vector<std::pair<std::function<std::unique_ptr<Task>()>, ResourceClass>> tasks) {
+            std::vector<int> ids;
+
+            if (tasks.empty())
+                return ids;
+
+            stageEnd.push_back(static_cast<int>(entry.size() + tasks.size()));
+
+            for (auto &[constructor, resourceClass] : tasks)
+                ids.push_back(addEntry(std::move(constructor), resourceClass));
+
+            return ids;
+        }
+
+        void setType(const std::string &type) {
+            this->type = type;
+        }
+
+        const std::string &getType() const {
+            return type;
+        }
+
+        int getTaskCount() const {
+            return static_cast<int>(entry.size());
+        }
+
+        /**
+         * @brief Get a task, whose constructor doesn't set the argument.
+         * 
+         * @param id the ID of the task
+         */
+        const TaskEntry &getEntry(int id) const {
+            return entry[id];
+        }
+
+        int getStageCount() const {
+            return static_cast<int>(stageEnd.size());
+        }
+
+        /**
+         * @brief Get the range of the IDs of the tasks in a stage.
+         * 
+         * @param stage the index of the stage
+         * @return the range [first, last)
+         */
+        std::pair<int, int> getStageRange(int stage) const {
+            return { stage == 0 ? 0 : stageEnd[stage - 1], stageEnd[stage] };
+        }
+
+        /**
+         * @brief Get the index of the stage which a task belongs to.
+         * 
+         * @param id the ID of the task
+         */
+        int getStage(int id) const {
+            return static_cast<int>(std::upper_bound(stageEnd.begin(), stageEnd.end(), id) - stageEnd.begin());
+        }
+
+        /**
+         * @brief Get the end of the stage after the task current, or std::nullopt
+         * if current is the end of the last stage.
+         * 
+         */
+        std::optional<int> getNextStageEnd(int current) const {
+            auto it = std::upper_bound(stageEnd.begin(), stageEnd.end(), current);
+
+            if (it == stageEnd.end())
+                return std::nullopt;
+
+            return *it;
+        }
+
+        /**
+         * @brief Check whether every stage from the task first on has only one
+         * task. first must be the start of a stage.
+         * 
+         */
+        bool isSequential(int first = 0) const {
+            auto stageCount = stageEnd.end() - std::upper_bound(stageEnd.begin(), stageEnd.end(), first);
+            return stageCount == static_cast<long>(entry.size()) - first;
+        }
+
+        /**
+         * @brief Check whether any task from the task first on is of the resource class.
+         * 
+         */
+        bool hasResourceClass(ResourceClass resourceClass, int first = 0) const {
+            return std::any_of(entry.begin() + first, entry.end(), [resourceClass](const TaskEntry &task) {
+                return task.resourceClass == resourceClass;
+            });
+        }
+    private:
+        std::vector<TaskEntry> entry;
+        std::vector<int> stageEnd;
+        std::string type;
+
+        int addEntry(std::function<std::unique_ptr<Task>()> constructor, ResourceClass resourceClass) {
+            int id = static_cast<int>(entry.size());
+            entry.emplace_back(id, std::move(constructor), resourceClass);
+            return id;
+        }
+    };
+
+    /**
+     * @brief A class which stores a group of tasks. The tasks are kept in a
+     * TaskLayout, which is copied only when a group sharing it is changed.
+     * Add the tasks before the group is shared with other threads, e.g. before
+     * it's executed, since the copy on write can't see the copies made by them.
      * 
      */
     class TaskGroup {
     public:
         TaskGroup(std::shared_ptr<Variable::Argument> arg) :
+            TaskGroup(std::move(arg), std::make_shared<TaskLayout>()) {}
+
+        /**
+         * @brief Create a group with the tasks of layout, which may be shared by
+         * other groups.
+         * 
+         * @param arg the argument
+         * @param layout the tasks and the stages
+         */
+        TaskGroup(std::shared_ptr<Variable::Argument> arg, std::shared_ptr<TaskLayout> layout) :
             current(0),
-            entry(),
-            arg(std::move(arg)) {}
+            layout(std::move(layout)),
+            arg(std::move(arg)),
+            token(CancellationToken::create()),
+            memoryEstimate(0),
+            costHint(1) {}
 
-        TaskGroup(const TaskGroup &) = default;
+        TaskGroup(const TaskGroup &other) :
+            current(other.current.load(std::memory_order_relaxed)),
+            layout(other.layout),
+            arg(other.arg),
+            token(other.token),
+            memoryEstimate(other.memoryEstimate),
+            costHint(other.costHint) {}
 
-        TaskGroup &operator=(const TaskGroup &) = default;
+        TaskGroup &operator=(const TaskGroup &other) {
+            current.store(other.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            layout = other.layout;
+            arg = other.arg;
+            token = other.token;
+            memoryEstimate = other.memoryEstimate;
+            costHint = other.costHint;
+            return *this;
+        }
 
-        TaskGroup(TaskGroup &&) = default;
+        TaskGroup(TaskGroup &&other) noexcept :
+            current(other.current.load(std::memory_order_relaxed)),
+            layout(std::move(other.layout)),
+            arg(std::move(other.arg)),
+            token(std::move(other.token)),
+            memoryEstimate(other.memoryEstimate),
+            costHint(other.costHint) {}
 
-        TaskGroup &operator=(TaskGroup &&) = default;
+        TaskGroup &operator=(TaskGroup &&other) noexcept {
+            current.store(other.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            layout = std::move(other.layout);
+            arg = std::move(other.arg);
+            token = std::move(other.token);
+            memoryEstimate = other.memoryEstimate;
+            costHint = other.costHint;
+            return *this;
+        }
 
         ~TaskGroup() {}
 
         /**
-         * @brief Add a task
+         * @brief Add a task as a new stage. It starts after all tasks added
+         * before have finished.
          * 
          * @param constructor the constructor of the task
+         * @param resourceClass the resource which limits the task
          * @return the id of this task in this TaskGroup
          */
-        int add(std::function<std::unique_ptr<Task>()> constructor) {
-            int id = static_cast<int>(entry.size());
+        int add(std::function<std::unique_ptr<Task>()> constructor,
+            ResourceClass resourceClass = ResourceClass::CPU) {
+            return getMutableLayout().add(std::move(constructor), resourceClass);
+        }
 
-            auto cont = [](const auto &cont, std::shared_ptr<Variable::Argument> arg) {
-                auto task = cont();
-                task->setArgument(arg);
-                return task;
-            };
-            
-            entry.emplace_back(id, std::bind(cont, std::move(constructor), arg));
-            
-            return id;
+        /**
+         * @brief Add some tasks as a new stage. They start together after all
+         * tasks added before have finished and may run at the same time.
+         * 
+         * @param constructors the constructors of the tasks
+         * @param resourceClass the resource which limits the tasks
+         * @return the ids of these tasks in this TaskGroup
+         */
+        std::vector<int> addParallel(std::vector<std::function<std::unique_ptr<Task>()>> constructors,
+            ResourceClass resourceClass = ResourceClass::CPU) {
+            return getMutableLayout().addParallel(std::move(constructors), resourceClass);
+        }
+
+        /**
+         * @brief Same as the above, but every task has its own resource class.
+         * 
+         * @param tasks the constructors and the resource classes of the tasks
+         * @return the ids of these tasks in this TaskGroup
+         */
+        std::vector<int> addParallel(std::vector<std::pair<std::function<std::unique_ptr<Task>()>, ResourceClass>> tasks) {
+            return getMutableLayout().addParallel(std::move(tasks));
         }
 
         /**
          * @brief Get the next task to be executed. Return std::nullopt if all tasks
-         * have finished.
+         * have finished. It can be called by several threads at the same time,
+         * and every task is taken once.
          *
          * @return the next task or std::nullopt
          */
         std::optional<TaskEntry> next() const {
-            if (current == static_cast<int>(entry.size()))
-                return std::nullopt;
+            int id = current.load(std::memory_order_relaxed);
+
+            do {
+                if (id == layout->getTaskCount())
+                    return std::nullopt;
+            } while (!current.compare_exchange_weak(id, id + 1, std::memory_order_acq_rel));
+
+            return bind(id);
+        }
+
+        std::shared_ptr<Variable::Argument> getArgument() const {
+            return arg;
+        }
+
+        const std::shared_ptr<TaskLayout> &getLayout() const {
+            return layout;
+        }
+
+        /**
+         * @brief Set the name of the type registered in a TaskGroupRegistry, which
+         * is used to create this group again in another process.
+         * 
+         * @param type the name of the type
+         */
+        void setType(const std::string &type) {
+            /** A shared layout usually has the type already. */
+            if (layout->getType() != type)
+                getMutableLayout().setType(type);
+        }
+
+        const std::string &getType() const {
+            return layout->getType();
+        }
 
-            return entry[current++];
+        /**
+         * @brief Set the estimated peak memory of all tasks in this group, which
+         * is used to decide how many groups can run at the same time.
+         * 
+         * @param memoryEstimate the memory in bytes, or 0 if unknown
+         */
+        void setMemoryEstimate(std::size_t memoryEstimate) {
+            this->memoryEstimate = memoryEstimate;
+        }
+
+        std::size_t getMemoryEstimate() const {
+            return memoryEstimate;
+        }
+
+        /**
+         * @brief Set the relative cost of this group compared with the others,
+         * which is used to estimate the remaining time.
+         * 
+         * @param costHint the cost, 1 by default
+         */
+        void setCostHint(double costHint) {
+            this->costHint = costHint;
+        }
+
+        double getCostHint() const {
+            return costHint;
+        }
+
+        /**
+         * @brief Skip all stages which haven't started yet.
+         * 
+         */
+        void cancel() const {
+            token.cancel();
+        }
+
+        bool isCancelled() const {
+            return token.isCancelled();
+        }
+
+        /**
+         * @brief Get the remaining tasks of the current stage. Return an empty
+         * std::vector if all tasks have finished or the group is cancelled.
+         * 
+         * @return the tasks which can be executed together
+         */
+        std::vector<TaskEntry> nextStage() const {
+            std::vector<TaskEntry> res;
+            auto [first, last] = nextStageRange();
+
+            for (int i = first; i < last; ++i)
+                res.push_back(bind(i));
+
+            return res;
+        }
+
+        /**
+         * @brief Same as nextStage(), but return the range of the IDs of the tasks
+         * instead of copying them. Create the tasks by createTask(). Like next(),
+         * a stage is taken once even if several threads call it together, and
+         * all tasks of the stage can run at the same time.
+         * 
+         * @return the range [first, last), which is empty if all tasks have
+         * finished or the group is cancelled
+         */
+        std::pair<int, int> nextStageRange() const {
+            int first = current.load(std::memory_order_relaxed);
+            std::optional<int> end;
+
+            do {
+                if (isCancelled() || !(end = layout->getNextStageEnd(first)).has_value())
+                    return { first, first };
+            } while (!current.compare_exchange_weak(first, end.value(), std::memory_order_acq_rel));
+
+            return { first, end.value() };
+        }
+
+        /**
+         * @brief Create a task with the argument and the token of this group.
+         * 
+         * @param id the ID of the task
+         * @return the task
+         */
+        std::unique_ptr<Task> createTask(int id) const {
+            auto task = layout->getEntry(id).constructor();
+            task->setGroupToken(token);
+            task->setArgument(arg);
+            return task;
+        }
+
+        const TaskEntry &getEntry(int id) const {
+            return layout->getEntry(id);
+        }
+
+        int getTaskCount() const {
+            return layout->getTaskCount();
+        }
+
+        int getStageCount() const {
+            return layout->getStageCount();
+        }
+
+        /**
+         * @brief Get the range of the IDs of the tasks in a stage.
+         * 
+         * @param stage the index of the stage
+         * @return the range [first, last)
+         */
+        std::pair<int, int> getStageRange(int stage) const {
+            return layout->getStageRange(stage);
+        }
+
+        /**
+         * @brief Get the index of the stage which a task belongs to.
+         * 
+         * @param id the ID of the task
+         */
+        int getStage(int id) const {
+            return layout->getStage(id);
+        }
+
+        /**
+         * @brief Check whether every stage not taken yet has only one task, so
+         * that the rest of the tasks can be executed one by one in the same thread.
+         * 
+         */
+        bool isSequential() const {
+            return layout->isSequential(current.load(std::memory_order_relaxed));
+        }
+
+        /**
+         * @brief Check whether any task not taken yet is of the resource class.
+         * 
+         */
+        bool hasResourceClass(ResourceClass resourceClass) const {
+            return layout->hasResourceClass(resourceClass, current.load(std::memory_order_relaxed));
         }
     private:
-        mutable int current;
-        std::vector<TaskEntry> entry;
+        /** The ID of the first task not taken yet. */
+        mutable std::atomic_int current;
+        std::shared_ptr<TaskLayout> layout;
         std::shared_ptr<Variable::Argument> arg;
+        CancellationToken token;
+        std::size_t memoryEstimate;
+        double costHint;
+
+        /** use_count() is only exact while no other thread copies this group. */
+        TaskLayout &getMutableLayout() {
+            if (layout.use_count() > 1)
+                layout = std::make_shared<TaskLayout>(*layout);
+
+            return *layout;
+        }
+
+        /**
+         * @brief Get a copy of a task whose constructor sets the argument and
+         * the token of this group.
+         * 
+         */
+        TaskEntry bind(int id) const {
+            const auto &entry = layout->getEntry(id);
+            return TaskEntry(entry.id, [constructor = entry.constructor, arg = arg, token = token]() {
+                auto task = constructor();
+                task->setGroupToken(token);
+                task->setArgument(arg);
+                return task;
+            }, entry.resourceClass);
+        }
     };
 } // namespace MultiGenerator::Workflow
@@ -0,0 +1,171 @@
+#define MULTIGENERATOR_MEMORY_TRACKING
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <filesystem>
+#include <cassert>
+
+#include <MultiGenerator/Context/Memory.hpp>
+#include <MultiGenerator/Interface/Template.hpp>
+
+namespace Context = MultiGenerator::Context;
+namespace Variable = MultiGenerator::Variable;
+namespace Interface = MultiGenerator::Interface;
+
+void testMemoryScope() {
+    auto &profile = Context::MemoryProfile::getInstance();
+    profile.clear();
+    /** Defining the macro turns the accounting on before main(). */
+    assert(Context::MemoryProfile::isEnabled());
+
+    auto outside = std::make_unique<char[]>(1 << 20);
+
+    {
+        MULTIGENERATOR_MEMORY_SCOPE(scope, "1", "solve");
+        auto first = std::make_unique<char[]>(1 << 20);
+        first.reset();
+        auto second = std::make_unique<char[]>(1 << 20);
+
+        /** Other threads aren't counted. */
+        std::thread([]() {
+            auto other = std::make_unique<char[]>(8 << 20);
+        }).join();
+    }
+
+    auto records = profile.getRecords();
+    assert(records.size() == 1);
+    assert(records[0].testcase == "1" && records[0].stage == "solve");
+    assert(records[0].peak >= (1 << 20) && records[0].peak < (2 << 20));
+    assert(records[0].total >= (2 << 20) && records[0].total < (3 << 20));
+    assert(profile.getPeak("1") == records[0].peak);
+    assert(profile.getPeak("2") == 0);
+
+    /** A bound profile takes the records of the thread instead. */
+    Context::MemoryProfile bound;
+
+    {
+        Context::MemoryProfileBinding binding(&bound);
+        MULTIGENERATOR_MEMORY_SCOPE(scope, "3", "solve");
+        auto values = std::make_unique<char[]>(1 << 20);
+    }
+
+    {
+        MULTIGENERATOR_MEMORY_SCOPE(scope, "3", "generate");
+        auto values = std::make_unique<char[]>(2 << 20);
+    }
+
+    assert(bound.getRecords().size() == 1);
+    assert(bound.getPeak("3") >= (1 << 20) && bound.getPeak("3") < (2 << 20));
+    assert(profile.getPeak("3") >= (2 << 20));
+    profile.clear();
+}
+
+class VectorGenerator : public Interface::GeneratingTask {
+private:
+    void generate(std::ostream &data, const Variable::DataConfig &config) override {
+        std::vector<int> values(std::stoi(config.get("n").value()));
+        data << values.size() << std::endl;
+    }
+};
+
+class VectorSolution : public Interface::SolutionTask {
+private:
+    void solve(std::istream &dataIn, std::ostream &dataOut, const Variable::DataConfig &) override {
+        std::size_t n;
+        dataIn >> n;
+        std::vector<long long> values(n);
+        dataOut << values.size() << std::endl;
+    }
+};
+
+void testMemoryReport() {
+    constexpr int TESTCASE_COUNT = 4;
+
+    Interface::NormalTemplate temp("memory");
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        temp.add<VectorGenerator, VectorSolution>(Interface::testcase(i, {
+            Interface::entry("n", i << 16)
+        }));
+    }
+
+    temp.execute(2);
+
+    auto records = temp.getMemoryReport();
+    assert(static_cast<int>(records.size()) == TESTCASE_COUNT * 2);
+
+    for (const auto &record : records) {
+        long long n = std::stoi(record.testcase) << 16;
+        long long size = n * (record.stage == "generate" ? 4 : 8);
+        assert(record.stage == "generate" || record.stage == "solve");
+        assert(record.peak >= size && record.total >= record.peak);
+    }
+
+    assert(temp.getMemoryPeak("4") >= (4 << 16) * 8);
+    assert(Context::MemoryProfile::getInstance().getRecords().empty());
+
+    namespace filesystem = std::filesystem;
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        auto name = "memory" + std::to_string(i);
+        filesystem::remove(filesystem::path(name + ".in"));
+        filesystem::remove(filesystem::path(name + ".out"));
+    }
+}
+
+void testConcurrentReports() {
+    constexpr int TEMPLATE_COUNT = 2;
+    constexpr int TESTCASE_COUNT = 8;
+
+    std::vector<std::unique_ptr<Interface::NormalTemplate>> temps;
+
+    for (int i = 0; i < TEMPLATE_COUNT; ++i) {
+        temps.push_back(std::make_unique<Interface::NormalTemplate>("concurrent" + std::to_string(i)));
+
+        for (int j = 1; j <= TESTCASE_COUNT; ++j) {
+            temps[i]->add<VectorGenerator, VectorSolution>(Interface::testcase(j, {
+                Interface::entry("n", (i + 1) << 16)
+            }));
+        }
+    }
+
+    /** Every template keeps the records of its own run. */
+    std::vector<std::thread> threads;
+
+    for (auto &temp : temps)
+        threads.emplace_back([&temp]() { temp->execute(2); });
+
+    for (auto &thread : threads)
+        thread.join();
+
+    for (int i = 0; i < TEMPLATE_COUNT; ++i) {
+        auto records = temps[i]->getMemoryReport();
+        assert(static_cast<int>(records.size()) == TESTCASE_COUNT * 2);
+        long long size = static_cast<long long>((i + 1) << 16) * 8;
+
+        for (int j = 1; j <= TESTCASE_COUNT; ++j) {
+            long long peak = temps[i]->getMemoryPeak(std::to_string(j));
+            assert(peak >= size && peak < size * 2);
+        }
+    }
+
+    namespace filesystem = std::filesystem;
+
+    for (int i = 0; i < TEMPLATE_COUNT; ++i) {
+        for (int j = 1; j <= TESTCASE_COUNT; ++j) {
+            auto name = "concurrent" + std::to_string(i) + std::to_string(j);
+            filesystem::remove(filesystem::path(name + ".in"));
+            filesystem::remove(filesystem::path(name + ".out"));
+        }
+    }
+}
+
+int main() {
+    testMemoryScope();
+    testMemoryReport();
+    testConcurrentReports();
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <cassert>
+#include <cstdio>
+
+#include <MultiGenerator/Context/Pipe.hpp>
+
+namespace Context = MultiGenerator::Context;
+
+void testPipeStream() {
+    constexpr int COUNT = 100000;
+
+    auto pipe = std::make_shared<Context::Pipe>();
+    long long sum = 0;
+
+    std::thread reader([&]() {
+        Context::PipeInputStream is(pipe);
+        int x;
+
+        while (is.getStream() >> x)
+            sum += x;
+    });
+
+    {
+        Context::PipeOutputStream os(pipe);
+
+        for (int i = 1; i <= COUNT; ++i)
+            os.getStream() << i << "\n";
+    }
+
+    reader.join();
+    assert(sum == 1LL * COUNT * (COUNT + 1) / 2);
+}
+
+void testPipeCloseRead() {
+    auto pipe = std::make_shared<Context::Pipe>();
+    pipe->closeRead();
+    pipe->write("dropped");
+    pipe->closeWrite();
+
+    std::string chunk;
+    assert(pipe->read(chunk) == false);
+}
+
+void testPipeBackpressure() {
+    constexpr int COUNT = 1000;
+
+    /** The writer has to wait for the reader after every chunk. */
+    auto pipe = std::make_shared<Context::Pipe>(1);
+
+    std::thread writer([&]() {
+        for (int i = 0; i < COUNT; ++i)
+            pipe->write(std::to_string(i));
+
+        pipe->closeWrite();
+    });
+
+    std::string chunk;
+
+    for (int i = 0; i < COUNT; ++i) {
+        bool res = pipe->read(chunk);
+        assert(res && chunk == std::to_string(i));
+    }
+
+    bool res = pipe->read(chunk);
+    assert(!res);
+    writer.join();
+}
+
+void testPipeSpill() {
+    constexpr int COUNT = 100000;
+    const std::string fileName = "pipe_spill.txt";
+
+    /** Nobody reads while writing, so the writer must not wait. */
+    auto pipe = std::make_shared<Context::Pipe>(2);
+    pipe->setSpillFile(fileName);
+
+    {
+        Context::TeeOutputStream os(std::make_unique<Context::FileOutputStream>(fileName),
+            std::make_unique<Context::PipeOutputStream>(pipe));
+
+        for (int i = 1; i <= COUNT; ++i)
+            os.getStream() << i << "\n";
+    }
+
+    assert(pipe->hasSpilled());
+    long long sum = 0;
+
+    {
+        Context::PipeInputStream is(pipe);
+        int x;
+
+        while (is.getStream() >> x)
+            sum += x;
+    }
+
+    assert(sum == 1LL * COUNT * (COUNT + 1) / 2);
+    std::remove(fileName.c_str());
+}
+
+void testTeeOutputStream() {
+    class TestOutputStream : public Context::OutputStream {
+    public:
+        TestOutputStream(std::ostringstream &oss) :
+            oss(oss) {}
+
+        std::ostream &getStream() override {
+            return oss;
+        }
+    private:
+        std::ostringstream &oss;
+    };
+
+    std::ostringstream first, second;
+
+    {
+        Context::TeeOutputStream os(std::make_unique<TestOutputStream>(first),
+            std::make_unique<TestOutputStream>(second));
+        os.getStream() << "test " << 42 << std::endl;
+    }
+
+    assert(first.str() == "test 42\n");
+    assert(second.str() == "test 42\n");
+}
+
+int main() {
+    testPipeStream();
+    testPipeCloseRead();
+    testPipeBackpressure();
+    testPipeSpill();
+    testTeeOutputStream();
+    return 0;
+}
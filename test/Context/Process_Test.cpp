@@ -0,0 +1,118 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <filesystem>
+#include <chrono>
+#include <cassert>
+
+#include <MultiGenerator/Context/Process.hpp>
+
+namespace Context = MultiGenerator::Context;
+
+Context::ProcessConfig shell(const std::string &command) {
+    Context::ProcessConfig config;
+    config.path = "/bin/sh";
+    config.arguments = { "-c", command };
+    return config;
+}
+
+void testProcessFile() {
+    {
+        std::ofstream ofs("process.in");
+        ofs << "1 2" << std::endl;
+    }
+
+    auto res = Context::Process::run(shell("read a b; echo $((a + b))"), "process.in", "process.out");
+    assert(res.isSuccessful());
+    assert(res.wallTime >= 0 && res.peakMemory > 0);
+
+    {
+        std::string str;
+        std::getline(std::ifstream("process.out"), str);
+        assert(str == "3");
+    }
+
+    std::filesystem::remove(std::filesystem::path("process.in"));
+    std::filesystem::remove(std::filesystem::path("process.out"));
+}
+
+void testProcessStream() {
+    std::string content;
+
+    for (int i = 0; i < 100000; ++i)
+        content += std::to_string(i) + "\n";
+
+    std::istringstream iss(content);
+    std::ostringstream oss;
+    auto res = Context::Process::run(shell("cat"), iss, oss);
+    assert(res.isSuccessful());
+    assert(oss.str() == content);
+
+    /** The child quits without reading all input. */
+    std::istringstream iss2(content);
+    std::ostringstream oss2;
+    res = Context::Process::run(shell("exit 3"), iss2, oss2);
+    assert(res.exitCode == 3 && res.signal == 0);
+}
+
+void testProcessLimit() {
+    auto config = shell("while :; do :; done");
+    config.cpuTimeLimit = 1;
+
+    std::istringstream iss;
+    std::ostringstream oss;
+    auto res = Context::Process::run(config, iss, oss);
+    assert(res.signal == SIGXCPU || res.signal == SIGKILL);
+    assert(res.cpuTime >= 0.9);
+}
+
+void testProcessCancel() {
+    auto start = std::chrono::steady_clock::now();
+    auto isCancelled = [start]() {
+        return std::chrono::steady_clock::now() - start > std::chrono::milliseconds(100);
+    };
+
+    std::istringstream iss;
+    std::ostringstream oss;
+    auto res = Context::Process::run(shell("sleep 10"), iss, oss, isCancelled);
+    assert(res.signal == SIGKILL);
+    assert(res.wallTime < 5);
+
+    {
+        std::ofstream ofs("process.in");
+    }
+
+    res = Context::Process::run(shell("sleep 10"), "process.in", "process.out", isCancelled);
+    assert(res.signal == SIGKILL);
+    assert(res.wallTime < 5);
+
+    std::filesystem::remove(std::filesystem::path("process.in"));
+    std::filesystem::remove(std::filesystem::path("process.out"));
+}
+
+void testProcessSpawnFailed() {
+    Context::ProcessConfig config;
+    config.path = "/nonexistent/program";
+
+    std::istringstream iss;
+    std::ostringstream oss;
+    bool thrown = false;
+
+    try {
+        Context::Process::run(config, iss, oss);
+    } catch (const Context::ProcessSpawnFailedException &) {
+        thrown = true;
+    }
+
+    assert(thrown);
+}
+
+int main() {
+    testProcessFile();
+    testProcessStream();
+    testProcessLimit();
+    testProcessCancel();
+    testProcessSpawnFailed();
+    return 0;
+}
@@ -132,6 +132,19 @@ void testOutputStream() {
     }
 }
 
+void testTraceOff() {
+    /** MULTIGENERATOR_TRACE isn't defined in this program, so nothing is recorded. */
+    assert(!Context::Trace::isEnabled());
+
+    {
+        Context::FileOutputStream ofs("tmp.txt");
+        ofs.getStream() << "test" << std::endl;
+    }
+
+    assert(Context::Trace::getInstance().getEventCount() == 0);
+    std::filesystem::remove(std::filesystem::path("tmp.txt"));
+}
+
 int main() {
     testStandardInputStream();
     testFileInputStream();
@@ -139,5 +152,6 @@ int main() {
     testStandardOutputStream();
     testFileOutputStream();
     testOutputStream();
+    testTraceOff();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,99 @@
+#define MULTIGENERATOR_TRACE
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <filesystem>
+#include <cassert>
+
+#include <MultiGenerator/Context/Trace.hpp>
+#include <MultiGenerator/Context/Stream.hpp>
+#include <MultiGenerator/Executor/ThreadPool.hpp>
+
+namespace Context = MultiGenerator::Context;
+namespace Workflow = MultiGenerator::Workflow;
+namespace Executor = MultiGenerator::Executor;
+
+void testTraceScope() {
+    auto &trace = Context::Trace::getInstance();
+    trace.clear();
+
+    {
+        MULTIGENERATOR_TRACE_SCOPE(scope, "solve \"1\"", "task");
+        MULTIGENERATOR_TRACE_ARGUMENT(scope, "testcase", "1");
+    }
+
+    std::thread([]() {
+        Context::Trace::getInstance().setThreadName("other");
+        MULTIGENERATOR_TRACE_SCOPE(scope, "generate", "task");
+    }).join();
+
+    assert(trace.getEventCount() == 2);
+
+    std::ostringstream oss;
+    trace.exportChromeTrace(oss);
+    auto str = oss.str();
+    assert(str.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+    assert(str.find("\"name\":\"solve \\\"1\\\"\"") != std::string::npos);
+    assert(str.find("\"args\":{\"testcase\":\"1\"}") != std::string::npos);
+    assert(str.find("\"args\":{\"name\":\"other\"}") != std::string::npos);
+}
+
+void testTraceStream() {
+    auto &trace = Context::Trace::getInstance();
+    trace.clear();
+
+    {
+        Context::FileOutputStream os("trace.txt");
+        os.getStream() << "12345";
+    }
+
+    {
+        Context::FileInputStream is("trace.txt");
+        std::string str;
+        is.getStream() >> str;
+    }
+
+    std::ostringstream oss;
+    trace.exportChromeTrace(oss);
+    auto str = oss.str();
+    assert(str.find("\"name\":\"write\"") != std::string::npos);
+    assert(str.find("\"name\":\"read\"") != std::string::npos);
+    assert(str.find("\"file\":\"trace.txt\",\"bytes\":\"5\"") != std::string::npos);
+    assert(str.find("\"bytes\":\"-1\"") == std::string::npos);
+
+    std::filesystem::remove(std::filesystem::path("trace.txt"));
+}
+
+class EmptyRunner : public Workflow::Runner {
+private:
+    void run() override {}
+};
+
+void testTraceQueueWait() {
+    auto &trace = Context::Trace::getInstance();
+    trace.clear();
+
+    Executor::ThreadPool pool;
+    pool.start(2);
+
+    for (int i = 0; i < 10; ++i)
+        pool.execute<EmptyRunner>();
+
+    pool.stop();
+
+    std::ostringstream oss;
+    trace.exportChromeTrace(oss);
+    auto str = oss.str();
+    assert(trace.getEventCount() == 10);
+    assert(str.find("\"name\":\"queue wait\"") != std::string::npos);
+    assert(str.find("\"args\":{\"name\":\"worker\"}") != std::string::npos);
+}
+
+int main() {
+    testTraceScope();
+    testTraceStream();
+    testTraceQueueWait();
+    return 0;
+}
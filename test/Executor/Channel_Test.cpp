@@ -127,8 +127,44 @@ void testChannel() {
     TestChannel::start(1000, 1000);
 }
 
+void testPingPong() {
+    using namespace std::literals::chrono_literals;
+    constexpr int ROUND_COUNT = 100000;
+
+    auto [pingSender, pingReceiver] = Executor::Channel<int>::create();
+    auto [pongSender, pongReceiver] = Executor::Channel<int>::create();
+
+    /** Every receive waits for a send from the other thread, by spinning or sleeping. */
+    std::thread echo([&pingReceiver = pingReceiver, &pongSender = pongSender]() {
+        while (auto res = pingReceiver.receive())
+            pongSender.send(res.value() + 1);
+
+        pongSender.reset();
+    });
+
+    for (int i = 0; i < ROUND_COUNT; ++i) {
+        pingSender.send(i);
+        auto res = pongReceiver.receive();
+        assert(res.has_value() && res.value() == i + 1);
+    }
+
+    /** A sleeping receiver wakes up when the channel is closed. */
+    std::thread closer([&pingSender = pingSender]() {
+        std::this_thread::sleep_for(20ms);
+        pingSender.reset();
+    });
+
+    auto last = pongReceiver.receive();
+    assert(!last.has_value());
+    closer.join();
+    echo.join();
+    last = pongReceiver.receiveFor(1ms);
+    assert(!last.has_value());
+}
+
 int main() {
     testSenderReceiverCount();
     testChannel();
+    testPingPong();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <cstdlib>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cassert>
+
+#include <MultiGenerator/Interface/Template.hpp>
+
+namespace Variable = MultiGenerator::Variable;
+namespace Executor = MultiGenerator::Executor;
+namespace Interface = MultiGenerator::Interface;
+
+/**
+ * A generator which crashes on its first run if "crash" is "once" or on every run
+ * if it's "always", and never returns if it's "hang".
+ */
+class CrashingGenerator : public Interface::GeneratingTask {
+private:
+    void generate(std::ostream &data, const Variable::DataConfig &config) override {
+        auto crash = config.getOr("crash", "never");
+        auto flag = "remote" + config.get("a").value() + ".flag";
+
+        if (crash == "always" || (crash == "once" && !std::filesystem::exists(flag))) {
+            std::ofstream ofs(flag);
+            ofs.close();
+            std::abort();
+        }
+
+        while (crash == "hang")
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        data << config.get("a").value() << " " << config.get("b").value() << std::endl;
+    }
+};
+
+class AddSolution : public Interface::SolutionTask {
+private:
+    void solve(std::istream &dataIn, std::ostream &dataOut, const Variable::DataConfig &) override {
+        int a, b;
+        dataIn >> a >> b;
+        dataOut << a + b << std::endl;
+    }
+};
+
+void testProcessExecutor() {
+    constexpr int TESTCASE_COUNT = 8;
+
+    Interface::NormalTemplate temp("remote");
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        std::string crash = (i == 3 ? "once" : (i == 5 ? "always" : (i == 7 ? "hang" : "never")));
+        temp.add<CrashingGenerator, AddSolution>(Interface::testcase(1, i, {
+            Interface::entry("a", i),
+            Interface::entry("b", i * 10),
+            { "crash", crash }
+        }));
+    }
+
+    /** The hanging generator ignores its cancellation, so only killing the worker stops it. */
+    temp.setTaskTimeLimit(std::chrono::milliseconds(500));
+    auto failures = temp.executeInProcesses(3);
+    /** Only the coordinator gets here. */
+    assert(!Executor::ProcessExecutor::isWorker());
+    assert(failures.size() == 2);
+    std::sort(failures.begin(), failures.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.testcase < rhs.testcase;
+    });
+    assert(failures[0].testcase == "1-5");
+    assert(failures[1].testcase == "1-7" && failures[1].reason.find("timed out") != std::string::npos);
+
+    namespace filesystem = std::filesystem;
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        auto name = "remote1-" + std::to_string(i);
+
+        if (i != 5 && i != 7) {
+            std::string str;
+            std::getline(std::ifstream(name + ".out"), str);
+            assert(str == std::to_string(i * 11));
+        }
+
+        filesystem::remove(filesystem::path(name + ".in"));
+        filesystem::remove(filesystem::path(name + ".out"));
+        filesystem::remove(filesystem::path("remote" + std::to_string(i) + ".flag"));
+    }
+}
+
+void testGroupDescriptor() {
+    auto arg = Interface::testcase(2, 7, { { "n", "10" }, { "name", "a:b|c" } });
+    Variable::DataConfig config;
+    MultiGenerator::Workflow::TaskGroup group(arg);
+    group.setType("type");
+
+    auto descriptor = Executor::GroupDescriptor::decode(
+        Executor::GroupDescriptor::create(4, group).encode());
+    assert(descriptor.index == 4 && descriptor.type == "type" && descriptor.argument == "2-7");
+
+    auto copy = descriptor.createArgument();
+    assert(copy->getID() == "2-7");
+    assert(copy->getConfig().get("n").value() == "10");
+    assert(copy->getConfig().get("name").value() == "a:b|c");
+}
+
+void testServeOutsideWorker() {
+    bool isThrown = false;
+
+    try {
+        Executor::ProcessExecutor::serve(MultiGenerator::Workflow::TaskGroupRegistry());
+    } catch (const Executor::WorkerEnvironmentInvalidException &) {
+        isThrown = true;
+    }
+
+    assert(isThrown);
+}
+
+int main() {
+    /** Worker processes run main() again and stop in executeInProcesses(). */
+    testProcessExecutor();
+    testGroupDescriptor();
+    testServeOutsideWorker();
+    return 0;
+}
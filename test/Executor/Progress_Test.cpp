@@ -0,0 +1,166 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <filesystem>
+#include <cassert>
+
+#include <MultiGenerator/Variable/Argument.hpp>
+#include <MultiGenerator/Workflow/TaskGroup.hpp>
+#include <MultiGenerator/Executor/TaskExecutor.hpp>
+#include <MultiGenerator/Executor/Progress.hpp>
+
+namespace Variable = MultiGenerator::Variable;
+namespace Workflow = MultiGenerator::Workflow;
+namespace Executor = MultiGenerator::Executor;
+
+class CollectingSink : public Executor::ProgressSink {
+public:
+    void report(const Executor::Progress &progress) override {
+        std::lock_guard<std::mutex> lock(mtx);
+        reports.push_back(progress);
+    }
+
+    std::vector<Executor::Progress> getReports() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return reports;
+    }
+private:
+    std::mutex mtx;
+    std::vector<Executor::Progress> reports;
+};
+
+class SleepingTask : public Workflow::Task {
+public:
+    void call() override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+};
+
+std::vector<Workflow::TaskGroup> createGroups() {
+    std::vector<Workflow::TaskGroup> groups;
+
+    for (int subtask = 1; subtask <= 2; ++subtask) {
+        for (int i = 1; i <= 10; ++i) {
+            groups.emplace_back(std::make_shared<Variable::SubtaskArgument>(subtask, i));
+            groups.back().add([]() {
+                return std::make_unique<SleepingTask>();
+            });
+            /** The second subtask has a parallel stage of two tasks. */
+            groups.back().addParallel(std::vector<std::function<std::unique_ptr<Workflow::Task>()>>(
+                subtask, []() {
+                    return std::make_unique<SleepingTask>();
+                }));
+            groups.back().setCostHint(subtask);
+        }
+    }
+
+    return groups;
+}
+
+void testProgressReporter() {
+    auto sink = std::make_shared<CollectingSink>();
+    auto reporter = std::make_shared<Executor::ProgressReporter>(sink, std::chrono::milliseconds(5));
+    auto groups = createGroups();
+
+    Executor::TaskExecutor executor;
+    executor.setProgressReporter(reporter);
+    executor.execute(groups, 2);
+
+    auto reports = sink->getReports();
+    assert(reports.size() >= 2);
+
+    for (std::size_t i = 1; i < reports.size(); ++i)
+        assert(reports[i].completed >= reports[i - 1].completed);
+
+    const auto &last = reports.back();
+    assert(last.isFinished);
+    assert(last.completed == 20 && last.total == 20);
+    assert(last.stages.size() == 2);
+    assert(last.stages[0].completed == 20 && last.stages[0].total == 20);
+    assert(last.stages[1].completed == 30 && last.stages[1].total == 30);
+    assert(last.subtasks.size() == 2);
+    assert(last.subtasks[0].id == 1 && last.subtasks[0].completed == 10 && last.subtasks[0].total == 10);
+    assert(last.subtasks[1].id == 2 && last.subtasks[1].completed == 10);
+
+    for (const auto &report : reports) {
+        if (!report.isFinished && report.completed > 0)
+            assert(report.eta.has_value() && report.eta.value() >= 0);
+    }
+}
+
+void testExtendedProgress() {
+    auto sink = std::make_shared<CollectingSink>();
+    auto reporter = std::make_shared<Executor::ProgressReporter>(sink, std::chrono::milliseconds(5));
+
+    Executor::TaskExecutor executor;
+    executor.setProgressReporter(reporter);
+    /** Two executions of a started reporter are reported as one. */
+    reporter->start({});
+
+    for (int i = 0; i < 2; ++i) {
+        auto groups = createGroups();
+        executor.execute(groups, 2);
+    }
+
+    assert(reporter->isRunning());
+    reporter->stop();
+
+    auto reports = sink->getReports();
+    int finishedCount = 0;
+
+    for (const auto &report : reports)
+        finishedCount += report.isFinished;
+
+    const auto &last = reports.back();
+    assert(finishedCount == 1 && last.isFinished);
+    assert(last.completed == 40 && last.total == 40);
+    assert(last.stages[1].completed == 60 && last.stages[1].total == 60);
+    assert(last.subtasks.size() == 2 && last.subtasks[1].completed == 20 && last.subtasks[1].total == 20);
+}
+
+void testStreamProgressSink() {
+    std::ostringstream oss;
+    Executor::StreamProgressSink sink(oss);
+    Executor::Progress progress;
+    progress.completed = 3;
+    progress.total = 10;
+    progress.eta = 2.5;
+    progress.subtasks.push_back({ 1, 3, 5 });
+    sink.report(progress);
+
+    auto str = oss.str();
+    assert(str.find("[3/10]") == 0);
+    assert(str.find("ETA 2.5 s") != std::string::npos);
+    assert(str.find("subtask 1 3/5") != std::string::npos);
+}
+
+void testFileProgressSink() {
+    Executor::FileProgressSink sink("progress.json");
+    Executor::Progress progress;
+    progress.completed = 3;
+    progress.total = 10;
+    progress.stages.push_back({ 0, 3, 10 });
+    sink.report(progress);
+
+    std::ifstream ifs("progress.json");
+    std::string str((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    assert(str.find("\"completed\":3,\"total\":10") != std::string::npos);
+    assert(str.find("\"eta\":null") != std::string::npos);
+    assert(str.find("\"stages\":[{\"id\":0,\"completed\":3,\"total\":10}]") != std::string::npos);
+    assert(!std::filesystem::exists("progress.json.tmp"));
+    ifs.close();
+    std::filesystem::remove("progress.json");
+}
+
+int main() {
+    testProgressReporter();
+    testExtendedProgress();
+    testStreamProgressSink();
+    testFileProgressSink();
+    return 0;
+}
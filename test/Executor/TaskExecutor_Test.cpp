@@ -1,11 +1,41 @@
 #include <iostream>
 #include <set>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <cstdlib>
+#include <stdexcept>
+#include <new>
 #include <cassert>
 
 #include <MultiGenerator/Variable/Argument.hpp>
 #include <MultiGenerator/Workflow/TaskGroup.hpp>
 #include <MultiGenerator/Executor/TaskExecutor.hpp>
 
+/** Count the allocations of the whole program. */
+std::atomic<std::size_t> allocationCount;
+
+void *operator new(std::size_t size) {
+    ++allocationCount;
+
+    if (void *ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+/** Not inlined, otherwise GCC warns that free() is called on the memory from operator new. */
+[[gnu::noinline]] void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
 namespace Variable = MultiGenerator::Variable;
 namespace Workflow = MultiGenerator::Workflow;
 namespace Executor = MultiGenerator::Executor;
@@ -75,7 +105,419 @@ void testTaskExecutor() {
         assert(result.count(i) == 1);
 }
 
+namespace TestMemoryBudget {
+    std::atomic<std::size_t> usedMemory;
+    std::atomic<std::size_t> peakMemory;
+    std::atomic_int finishedCount;
+
+    class MemoryTask : public Workflow::Task {
+    public:
+        MemoryTask(std::size_t memory) :
+            Workflow::Task(),
+            memory(memory) {}
+
+        void call() override {
+            auto used = (usedMemory += memory);
+            auto peak = peakMemory.load();
+
+            while (peak < used && !peakMemory.compare_exchange_weak(peak, used)) {}
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            usedMemory -= memory;
+            ++finishedCount;
+        }
+    private:
+        std::size_t memory;
+    };
+}
+
+/**
+ * @brief Create groups of two MemoryTask each, whose memory estimates are given.
+ *
+ */
+std::vector<Workflow::TaskGroup> createMemoryGroups(const std::vector<std::size_t> &memories) {
+    using namespace TestMemoryBudget;
+    std::vector<Workflow::TaskGroup> groups;
+
+    for (std::size_t i = 0; i < memories.size(); ++i) {
+        std::size_t memory = memories[i];
+        Workflow::TaskGroup group(std::make_shared<Variable::NormalArgument>(static_cast<int>(i),
+            Variable::DataConfig()));
+
+        for (int j = 0; j < 2; ++j) {
+            group.add([memory]() {
+                return std::make_unique<MemoryTask>(memory);
+            });
+        }
+
+        group.setMemoryEstimate(memory);
+        groups.push_back(std::move(group));
+    }
+
+    return groups;
+}
+
+void testMemoryBudget() {
+    using namespace TestMemoryBudget;
+    constexpr std::size_t BUDGET = 100;
+
+    /** A large group every ten groups, a group larger than the budget and some small ones. */
+    std::vector<std::size_t> memories;
+
+    for (int i = 0; i < 40; ++i)
+        memories.push_back(i % 10 == 0 ? 70 : (i == 5 ? 150 : 10));
+
+    Executor::TaskExecutor executor;
+    executor.setMemoryBudget(BUDGET);
+    auto groups = createMemoryGroups(memories);
+    executor.execute(groups, 8);
+
+    assert(finishedCount == 80);
+    assert(usedMemory == 0);
+    /** Only the group larger than the budget may exceed it, and it runs alone. */
+    assert(peakMemory <= 150);
+
+    /** The groups are used up, so run new ones without the large group. */
+    usedMemory = peakMemory = 0;
+    finishedCount = 0;
+    memories.erase(memories.begin() + 5);
+    groups = createMemoryGroups(memories);
+    executor.execute(groups, 8);
+
+    assert(finishedCount == 78);
+    assert(peakMemory > 0 && peakMemory <= BUDGET);
+}
+
+void testMaxActiveGroupCount() {
+    using namespace TestMemoryBudget;
+    usedMemory = peakMemory = 0;
+
+    Executor::TaskExecutor executor;
+    std::vector<Workflow::TaskGroup> groups;
+
+    for (int i = 0; i < 20; ++i) {
+        Workflow::TaskGroup group(std::make_shared<Variable::NormalArgument>(i, Variable::DataConfig()));
+        group.add([]() {
+            return std::make_unique<MemoryTask>(1);
+        });
+        groups.push_back(std::move(group));
+    }
+
+    executor.setMaxActiveGroupCount(3);
+    executor.execute(groups, 8);
+    assert(peakMemory <= 3);
+}
+
+namespace TestResourceClass {
+    std::mutex mtx;
+    std::condition_variable cond;
+    bool isWritten = false;
+    bool isSeen = false;
+
+    class WritingTask : public Workflow::Task {
+    public:
+        void call() override {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                isWritten = true;
+            }
+
+            cond.notify_all();
+        }
+    };
+
+    class ComputingTask : public Workflow::Task {
+    public:
+        void call() override {
+            std::unique_lock<std::mutex> lock(mtx);
+            isSeen = cond.wait_for(lock, std::chrono::seconds(5), []() { return isWritten; });
+        }
+    };
+}
+
+std::vector<Workflow::TaskGroup> createResourceGroups() {
+    using namespace TestResourceClass;
+
+    std::vector<Workflow::TaskGroup> groups;
+    groups.emplace_back(std::make_shared<Variable::NormalArgument>(1, Variable::DataConfig()));
+    groups.emplace_back(std::make_shared<Variable::NormalArgument>(2, Variable::DataConfig()));
+    /** The only CPU slot is taken by a task waiting for an I/O task. */
+    groups[0].add([]() {
+        return std::make_unique<ComputingTask>();
+    });
+    groups[1].add([]() {
+        return std::make_unique<WritingTask>();
+    }, Workflow::ResourceClass::IO);
+    return groups;
+}
+
+void testResourceClass() {
+    using namespace TestResourceClass;
+
+    Executor::TaskExecutor executor;
+    auto groups = createResourceGroups();
+    executor.setIOParallelCount(1);
+    executor.execute(groups, 1);
+    assert(isSeen);
+
+    /** The I/O task isn't packed into the batch of the waiting task. */
+    isWritten = isSeen = false;
+    groups = createResourceGroups();
+    executor.setBatchGranularity(std::chrono::milliseconds(1));
+    executor.execute(groups, 1);
+    assert(isSeen);
+}
+
+namespace TestTaskCoalescing {
+    std::vector<int> values;
+
+    class WritingTask : public Workflow::Task {
+    public:
+        void call() override {
+            values[std::stoi(arg->getID())] = 1;
+        }
+    };
+
+    class AddingTask : public Workflow::Task {
+    public:
+        void call() override {
+            /** The previous stage of the same group must have finished. */
+            assert(values[std::stoi(arg->getID())] == 1);
+            values[std::stoi(arg->getID())] = 2;
+        }
+    };
+}
+
+void testTaskCoalescing() {
+    using namespace TestTaskCoalescing;
+    constexpr int GROUP_COUNT = 5000;
+
+    values.assign(GROUP_COUNT, 0);
+    Executor::TaskExecutor executor;
+    std::vector<Workflow::TaskGroup> groups;
+
+    for (int i = 0; i < GROUP_COUNT; ++i) {
+        groups.emplace_back(std::make_shared<Variable::NormalArgument>(i, Variable::DataConfig()));
+        groups[i].add([]() {
+            return std::make_unique<WritingTask>();
+        });
+        groups[i].add([]() {
+            return std::make_unique<AddingTask>();
+        });
+    }
+
+    executor.setBatchGranularity(std::chrono::milliseconds(1));
+    executor.execute(groups, 4);
+
+    assert(std::count(values.begin(), values.end(), 2) == GROUP_COUNT);
+    assert(executor.getBatchCount() < GROUP_COUNT / 2);
+
+    /** The I/O stages go to the I/O pool, and only the rest of the groups are packed. */
+    values.assign(GROUP_COUNT, 0);
+
+    for (int i = 0; i < GROUP_COUNT; ++i) {
+        groups[i] = Workflow::TaskGroup(std::make_shared<Variable::NormalArgument>(i, Variable::DataConfig()));
+        groups[i].add([]() {
+            return std::make_unique<WritingTask>();
+        }, Workflow::ResourceClass::IO);
+        groups[i].add([]() {
+            return std::make_unique<AddingTask>();
+        });
+    }
+
+    executor.setIOParallelCount(2);
+    executor.execute(groups, 4);
+
+    assert(std::count(values.begin(), values.end(), 2) == GROUP_COUNT);
+    assert(executor.getBatchCount() > 0 && executor.getBatchCount() < GROUP_COUNT);
+}
+
+namespace TestFailurePolicy {
+    std::atomic_int finishedCount;
+
+    class ThrowingTask : public Workflow::Task {
+    public:
+        void call() override {
+            throw std::runtime_error("broken generator");
+        }
+    };
+
+    class CountingTask : public Workflow::Task {
+    public:
+        void call() override {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ++finishedCount;
+        }
+    };
+
+    std::vector<Workflow::TaskGroup> createGroups() {
+        std::vector<Workflow::TaskGroup> groups;
+
+        for (int i = 0; i < 50; ++i) {
+            groups.emplace_back(std::make_shared<Variable::NormalArgument>(i, Variable::DataConfig()));
+            groups[i].add([]() {
+                return std::make_unique<CountingTask>();
+            });
+
+            if (i == 0) {
+                groups[i].add([]() {
+                    return std::make_unique<ThrowingTask>();
+                });
+            }
+
+            groups[i].add([]() {
+                return std::make_unique<CountingTask>();
+            });
+        }
+
+        return groups;
+    }
+}
+
+void testFailurePolicy() {
+    using namespace TestFailurePolicy;
+
+    Executor::TaskExecutor executor;
+    auto groups = createGroups();
+    finishedCount = 0;
+    auto failures = executor.execute(groups, 2);
+
+    assert(failures.size() == 1);
+    assert(failures[0].testcase == "0");
+    assert(failures[0].task == 1);
+    assert(failures[0].reason == "broken generator");
+    /** Only the stage after the failed task is skipped. */
+    assert(groups[0].isCancelled());
+    assert(finishedCount == 99);
+
+    groups = createGroups();
+    finishedCount = 0;
+    executor.setFailurePolicy(Executor::FailurePolicy::FailFast);
+    executor.setMaxActiveGroupCount(2);
+    failures = executor.execute(groups, 2);
+
+    assert(failures.size() == 1);
+    assert(failures[0].testcase == "0");
+    /** The groups which haven't started are skipped. */
+    assert(finishedCount < 10);
+    assert(groups.back().isCancelled());
+
+    /** Every group fails twice in one stage but is reported once. */
+    groups.clear();
+
+    for (int i = 0; i < 1000; ++i) {
+        groups.emplace_back(std::make_shared<Variable::NormalArgument>(i, Variable::DataConfig()));
+        groups[i].addParallel({
+            []() { return std::make_unique<ThrowingTask>(); },
+            []() { return std::make_unique<ThrowingTask>(); }
+        });
+    }
+
+    executor.setFailurePolicy(Executor::FailurePolicy::ContinueAndReport);
+    executor.setMaxActiveGroupCount(0);
+    failures = executor.execute(groups, 4);
+    assert(failures.size() == groups.size());
+}
+
+namespace TestTaskTimeLimit {
+    /** A task which loops until it's cancelled. */
+    class LoopingTask : public Workflow::Task {
+    public:
+        void call() override {
+            while (!isCancelled())
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+}
+
+void testTaskTimeLimit() {
+    using namespace TestTaskTimeLimit;
+    using TestFailurePolicy::CountingTask;
+    using TestFailurePolicy::finishedCount;
+
+    Executor::TaskExecutor executor;
+    std::vector<Workflow::TaskGroup> groups;
+
+    for (int i = 0; i < 4; ++i) {
+        groups.emplace_back(std::make_shared<Variable::NormalArgument>(i, Variable::DataConfig()));
+
+        if (i == 2) {
+            groups[i].add([]() {
+                return std::make_unique<LoopingTask>();
+            });
+        }
+
+        groups[i].add([]() {
+            return std::make_unique<CountingTask>();
+        });
+    }
+
+    finishedCount = 0;
+    executor.setTaskTimeLimit(std::chrono::milliseconds(50));
+    auto failures = executor.execute(groups, 2);
+
+    assert(failures.size() == 1);
+    assert(failures[0].testcase == "2");
+    assert(failures[0].task == 0);
+    assert(failures[0].reason.find("TaskTimeoutException") == 0);
+    assert(finishedCount == 3);
+}
+
+namespace TestDispatchAllocation {
+    class EmptyTask : public Workflow::Task {
+    public:
+        void call() override {}
+    };
+
+    /**
+     * @brief Count the allocations of executing groupCount group(s) of stageCount stages.
+     * 
+     */
+    std::size_t countAllocation(Executor::TaskExecutor &executor, int groupCount, int stageCount) {
+        std::vector<Workflow::TaskGroup> groups;
+
+        for (int i = 0; i < groupCount; ++i) {
+            groups.emplace_back(std::make_shared<Variable::NormalArgument>(i, Variable::DataConfig()));
+
+            for (int j = 0; j < stageCount; ++j) {
+                groups[i].add([]() {
+                    return std::make_unique<EmptyTask>();
+                });
+            }
+        }
+
+        auto before = allocationCount.load();
+        executor.execute(groups, 2);
+        return allocationCount.load() - before;
+    }
+}
+
+void testDispatchAllocation() {
+    using namespace TestDispatchAllocation;
+    constexpr int STAGE_COUNT = 1000;
+
+    Executor::TaskExecutor executor;
+    /** Warm up the pools with more tasks in flight than one group ever has. */
+    countAllocation(executor, 16, 100);
+
+    auto small = countAllocation(executor, 1, STAGE_COUNT);
+    auto large = countAllocation(executor, 1, STAGE_COUNT * 2);
+    /** The tokens of a task are empty until it is added to a group, so only the task itself is allocated. */
+    auto before = allocationCount.load();
+    std::make_unique<EmptyTask>();
+    assert(allocationCount.load() - before == 1);
+    /** Nothing but the tasks themselves is allocated for the extra stages. */
+    assert(large - small == STAGE_COUNT);
+}
+
 int main() {
     testTaskExecutor();
+    testMemoryBudget();
+    testMaxActiveGroupCount();
+    testResourceClass();
+    testDispatchAllocation();
+    testTaskCoalescing();
+    testFailurePolicy();
+    testTaskTimeLimit();
     return 0;
 }
\ No newline at end of file
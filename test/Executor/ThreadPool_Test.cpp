@@ -0,0 +1,167 @@
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <cassert>
+
+#include <MultiGenerator/Workflow/Runner.hpp>
+#include <MultiGenerator/Executor/ThreadPool.hpp>
+
+namespace Workflow = MultiGenerator::Workflow;
+namespace Executor = MultiGenerator::Executor;
+
+using namespace std::literals::chrono_literals;
+
+/**
+ * @brief A gate which keeps the runners waiting until it's opened, so that the
+ * test knows how many runners have started without sleeping.
+ *
+ */
+class Gate {
+public:
+    Gate() :
+        mtx(),
+        cond(),
+        isOpen(false),
+        startedCount(0),
+        finishedCount(0) {}
+
+    void pass() {
+        std::unique_lock<std::mutex> lock(mtx);
+        ++startedCount;
+        cond.notify_all();
+        cond.wait(lock, [this]() { return isOpen; });
+        ++finishedCount;
+        cond.notify_all();
+    }
+
+    void open() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            isOpen = true;
+        }
+
+        cond.notify_all();
+    }
+
+    /**
+     * @brief Wait until more than count runners have started, or the timeout.
+     *
+     * @return whether enough runners have started
+     */
+    bool waitStarted(int count, std::chrono::milliseconds timeout = 5s) {
+        std::unique_lock<std::mutex> lock(mtx);
+        return cond.wait_for(lock, timeout, [this, count]() { return startedCount >= count; });
+    }
+
+    void waitFinished(int count) {
+        std::unique_lock<std::mutex> lock(mtx);
+        cond.wait(lock, [this, count]() { return finishedCount >= count; });
+    }
+
+    int getStartedCount() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return startedCount;
+    }
+
+    int getFinishedCount() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return finishedCount;
+    }
+private:
+    std::mutex mtx;
+    std::condition_variable cond;
+    bool isOpen;
+    int startedCount;
+    int finishedCount;
+};
+
+class WaitingRunner : public Workflow::Runner {
+public:
+    WaitingRunner(Gate &gate) :
+        Workflow::Runner(),
+        gate(gate) {}
+private:
+    Gate &gate;
+
+    void run() override {
+        /** Waiting uses no CPU time like waiting for I/O. */
+        gate.pass();
+    }
+};
+
+void testFixedThreadPool() {
+    Gate gate;
+    Executor::ThreadPool pool(4);
+    assert(pool.getWorkerCount() == 4);
+
+    for (int i = 0; i < 16; ++i)
+        pool.execute<WaitingRunner>(gate);
+
+    /** All workers are blocked, but a fixed pool adds none. */
+    assert(gate.waitStarted(4));
+    assert(gate.getStartedCount() == 4);
+    assert(pool.getWorkerCount() == 4);
+    gate.open();
+    gate.waitFinished(16);
+    assert(pool.getPeakWorkerCount() == 4);
+    pool.stop();
+
+    assert(gate.getFinishedCount() == 16);
+    assert(pool.getWorkerCount() == 0);
+
+    /** The pool can be started again. */
+    pool.start(2);
+    pool.execute<WaitingRunner>(gate);
+    pool.stop();
+    assert(gate.getFinishedCount() == 17);
+}
+
+void testElasticThreadPool() {
+    Gate gate;
+    Executor::ThreadPool pool;
+    pool.start(2, 8, 50ms);
+    assert(pool.getWorkerCount() == 2);
+
+    for (int i = 0; i < 32; ++i)
+        pool.execute<WaitingRunner>(gate);
+
+    /** The blocked workers are replaced by new ones, until the max count. */
+    assert(gate.waitStarted(8));
+    assert(pool.getPeakWorkerCount() == 8);
+    gate.open();
+    gate.waitFinished(32);
+    assert(pool.getPeakWorkerCount() <= 8);
+
+    /** The extra workers quit after being idle, which can only be polled. */
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+
+    while (pool.getWorkerCount() > 2 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(10ms);
+
+    assert(pool.getWorkerCount() == 2);
+    assert(pool.getIdleWorkerCount() == 2);
+    pool.stop();
+    assert(pool.getWorkerCount() == 0);
+}
+
+void testInvalidWorkerCount() {
+    Executor::ThreadPool pool;
+    bool thrown = false;
+
+    try {
+        pool.start(4, 2, 1ms);
+    } catch (const Executor::WorkerCountRangeInvalidException &) {
+        thrown = true;
+    }
+
+    assert(thrown);
+}
+
+int main() {
+    testFixedThreadPool();
+    testElasticThreadPool();
+    testInvalidWorkerCount();
+    return 0;
+}
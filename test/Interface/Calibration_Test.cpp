@@ -0,0 +1,201 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <thread>
+#include <chrono>
+#include <stdexcept>
+#include <filesystem>
+#include <cassert>
+
+#include <MultiGenerator/Interface/Template.hpp>
+
+namespace Variable = MultiGenerator::Variable;
+namespace Interface = MultiGenerator::Interface;
+
+class AddGenerator : public Interface::GeneratingTask {
+private:
+    void generate(std::ostream &data, const Variable::DataConfig &config) override {
+        int a = std::stoi(config.get("a").value());
+        int b = std::stoi(config.get("b").value());
+        data << a << " " << b << std::endl;
+    }
+};
+
+/** A solution which sleeps for a milliseconds. */
+class SleepingAddSolution : public Interface::SolutionTask {
+private:
+    void solve(std::istream &dataIn, std::ostream &dataOut, const Variable::DataConfig &) override {
+        int a, b;
+        dataIn >> a >> b;
+        std::this_thread::sleep_for(std::chrono::milliseconds(a));
+        dataOut << a + b << std::endl;
+    }
+};
+
+/** A solution which throws when a is 3. */
+class ThrowingAddSolution : public Interface::SolutionTask {
+private:
+    void solve(std::istream &dataIn, std::ostream &dataOut, const Variable::DataConfig &) override {
+        int a, b;
+        dataIn >> a >> b;
+
+        if (a == 3)
+            throw std::runtime_error("a is 3");
+
+        dataOut << a + b << std::endl;
+    }
+};
+
+void testTimeStatistics() {
+    auto statistics = Interface::TimeStatistics::create({ 5, 1, 3, 2, 4 });
+    assert(statistics.min == 1);
+    assert(statistics.median == 3);
+    assert(statistics.p99 == 5);
+
+    statistics = Interface::TimeStatistics::create({ 4, 1, 3, 2 });
+    assert(statistics.median == 2.5);
+}
+
+void testCalibration() {
+    constexpr int TESTCASE_COUNT = 4;
+
+    Interface::NormalTemplate temp("calibrate");
+
+    /**
+     * The bands are far from the sleeping times so that only the direction of
+     * the classification is checked: the first test case is within a wide band,
+     * the second is too slow, the third is too fast and the last has no band.
+     */
+    std::vector<std::vector<std::pair<std::string, std::string>>> pairs = {
+        { Interface::entry("timeUpperBound", 1.0) },
+        { Interface::entry("timeUpperBound", 0.005) },
+        { Interface::entry("timeLowerBound", 1.0) },
+        {}
+    };
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        pairs[i - 1].push_back(Interface::entry("a", i * 5));
+        pairs[i - 1].push_back(Interface::entry("b", i));
+        temp.add<AddGenerator, SleepingAddSolution>(Interface::testcase((i + 1) / 2, i,
+            Variable::DataConfig(pairs[i - 1])));
+    }
+
+    temp.execute(2);
+
+    Interface::CalibrationConfig config;
+    config.runCount = 3;
+    config.threadCount = 2;
+    auto report = temp.calibrate(config);
+
+    const auto &results = report.getResults();
+    assert(static_cast<int>(results.size()) == TESTCASE_COUNT * 2);
+
+    /** The results are ordered by the test cases, then by the cache modes. */
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto &result = results[i];
+        assert(result.testcase == std::to_string((i / 2 + 2) / 2) + "-" + std::to_string(i / 2 + 1));
+        assert(result.wallTimes.size() == 3 && result.cpuTimes.size() == 3);
+        assert(result.wallTime.min <= result.wallTime.median);
+        assert(result.wallTime.median <= result.wallTime.p99);
+        assert(result.wallTime.min >= static_cast<double>(i / 2 + 1) * 0.005);
+    }
+
+    assert(results[0].cacheMode == Interface::CacheMode::Warm);
+    assert(results[1].cacheMode == Interface::CacheMode::Cold);
+
+    const auto &subtasks = report.getSubtasks();
+    assert(subtasks.size() == 4);
+    assert(subtasks[0].subtask == 1 && subtasks[3].subtask == 2);
+    assert(subtasks[0].wallTime.min >= 0.005 && subtasks[0].wallTime.p99 >= 0.01);
+
+    auto outOfBand = report.getOutOfBand();
+    assert(static_cast<int>(outOfBand.size()) == 2 * 2);
+
+    for (const auto &result : outOfBand) {
+        if (result.testcase == results[2].testcase)
+            assert(result.wallTime.median > 0.005);
+        else
+            assert(result.testcase == results[4].testcase && result.wallTime.median < 1.0);
+    }
+
+    namespace filesystem = std::filesystem;
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        auto name = "calibrate" + results[(i - 1) * 2].testcase;
+        /** The standard answers are kept and the calibration answers are removed. */
+        assert(filesystem::exists(filesystem::path(name + ".out")));
+        assert(!filesystem::exists(filesystem::path(name + ".calibration.out")));
+        filesystem::remove(filesystem::path(name + ".in"));
+        filesystem::remove(filesystem::path(name + ".out"));
+    }
+}
+
+void testCalibrationFailure() {
+    constexpr int TESTCASE_COUNT = 4;
+
+    Interface::NormalTemplate temp("calibrate_failure");
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        temp.add<AddGenerator, ThrowingAddSolution>(Interface::testcase(i, {
+            Interface::entry("a", i),
+            Interface::entry("b", i)
+        }));
+    }
+
+    auto failures = temp.execute(2);
+    assert(failures.size() == 1);
+
+    Interface::CalibrationConfig config;
+    config.runCount = 2;
+    config.threadCount = 2;
+    /** The input of the failed test case is still there, so the calibration throws again. */
+    auto report = temp.calibrate(config);
+
+    auto failed = report.getFailed();
+    assert(failed.size() == 2);
+
+    for (const auto &result : failed)
+        assert(result.testcase == "3" && result.reason == "a is 3" && !result.isOutOfBand);
+
+    for (const auto &result : report.getResults()) {
+        if (result.testcase != "3")
+            assert(result.reason.empty() && result.wallTimes.size() == 2);
+    }
+
+    namespace filesystem = std::filesystem;
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        auto name = "calibrate_failure" + std::to_string(i);
+        filesystem::remove(filesystem::path(name + ".in"));
+        filesystem::remove(filesystem::path(name + ".out"));
+    }
+}
+
+void testInvalidBound() {
+    Interface::NormalTemplate temp("calibrate_bound");
+    temp.add<AddGenerator, SleepingAddSolution>(Interface::testcase(1, {
+        Interface::entry("a", 1),
+        Interface::entry("b", 1),
+        { "timeUpperBound", "fast" }
+    }));
+
+    bool isThrown = false;
+
+    try {
+        temp.calibrate();
+    } catch (const Interface::CalibrationBoundInvalidException &) {
+        isThrown = true;
+    }
+
+    assert(isThrown);
+}
+
+int main() {
+    testTimeStatistics();
+    testCalibration();
+    testCalibrationFailure();
+    testInvalidBound();
+    return 0;
+}
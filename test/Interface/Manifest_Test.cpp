@@ -0,0 +1,137 @@
+#include <fstream>
+#include <string>
+#include <filesystem>
+#include <cassert>
+
+#include <MultiGenerator/Interface/Template.hpp>
+
+namespace Variable = MultiGenerator::Variable;
+namespace Interface = MultiGenerator::Interface;
+
+class AddGenerator : public Interface::GeneratingTask {
+private:
+    void generate(std::ostream &data, const Variable::DataConfig &config) override {
+        int a = std::stoi(config.get("a").value());
+        int b = std::stoi(config.get("b").value());
+        data << a << " " << b << std::endl;
+    }
+};
+
+class AddSolution : public Interface::SolutionTask {
+private:
+    void solve(std::istream &dataIn, std::ostream &dataOut, const Variable::DataConfig &) override {
+        int a, b;
+        dataIn >> a >> b;
+        dataOut << a + b << std::endl;
+    }
+};
+
+class SubSolution : public Interface::SolutionTask {
+private:
+    void solve(std::istream &dataIn, std::ostream &dataOut, const Variable::DataConfig &) override {
+        int a, b;
+        dataIn >> a >> b;
+        dataOut << a - b << std::endl;
+    }
+};
+
+void testParse() {
+    auto manifest = Interface::Manifest::parse(
+        "# the samples\n"
+        "testcase add a=1 b=2\n"
+        "\n"
+        "subtask 1 b=10\n"
+        "testcase add a=3\n"
+        "testcase sub a=4 b=5\r\n"
+        "subtask 2\n"
+        "  testcase add\ta=5   b=6");
+
+    const auto &types = manifest.getTypes();
+    assert(types.size() == 2 && types[0] == "add" && types[1] == "sub");
+
+    const auto &entries = manifest.getEntries();
+    assert(entries.size() == 4);
+    assert(entries[0].arg->getID() == "1" && entries[0].type == 0);
+    assert(entries[1].arg->getID() == "1-1" && entries[1].line == 5);
+    assert(entries[1].arg->getConfig().get("b").value() == "10");
+    assert(entries[2].arg->getID() == "1-2" && entries[2].type == 1);
+    assert(entries[2].arg->getConfig().get("b").value() == "5");
+    assert(entries[3].arg->getID() == "2-1");
+    assert(entries[3].arg->getConfig().get("a").value() == "5");
+}
+
+void testInvalid() {
+    for (const auto &text : { "testcase", "subtask x", "testcase add a", "solve add" }) {
+        try {
+            Interface::Manifest::parse(std::string("# comment\n") + text);
+            assert(false);
+        } catch (const Interface::ManifestException &e) {
+            assert(std::string(e.what()).find("Line 2") != std::string::npos);
+        }
+    }
+}
+
+void testLoad() {
+    namespace filesystem = std::filesystem;
+
+    {
+        std::ofstream file("manifest.txt");
+        file << "testcase add a=1 b=2\ntestcase sub a=7 b=3\n";
+    }
+
+    Interface::NormalTemplate temp("manifest");
+    temp.define<AddGenerator, AddSolution>("add");
+    temp.define<AddGenerator, SubSolution>("sub");
+    temp.load(Interface::Manifest::load("manifest.txt"));
+    auto failures = temp.execute(2);
+    assert(failures.empty());
+
+    std::ifstream answer("manifest2.out");
+    int res;
+    answer >> res;
+    assert(res == 4);
+
+    /** An undefined type adds nothing and is reported at its first test case. */
+    auto undefined = Interface::Manifest::parse("testcase add a=1 b=2\ntestcase mul a=1 b=2\ntestcase mul a=3 b=4");
+    assert(undefined.getTypeLine(0) == 1 && undefined.getTypeLine(1) == 2);
+
+    try {
+        temp.load(undefined);
+        assert(false);
+    } catch (const Interface::ManifestException &e) {
+        assert(std::string(e.what()).find("Line 2") != std::string::npos);
+    }
+
+    filesystem::remove(filesystem::path("manifest.txt"));
+
+    for (int i = 1; i <= 2; ++i) {
+        filesystem::remove(filesystem::path("manifest" + std::to_string(i) + ".in"));
+        filesystem::remove(filesystem::path("manifest" + std::to_string(i) + ".out"));
+    }
+}
+
+void testLargeManifest() {
+    constexpr int TESTCASE_COUNT = 5000;
+    std::string text;
+
+    for (int i = 0; i < TESTCASE_COUNT; ++i)
+        text += "testcase add a=" + std::to_string(i) + " b=" + std::to_string(i * 2) + "\n";
+
+    auto manifest = Interface::Manifest::parse(text);
+    const auto &entries = manifest.getEntries();
+    assert(static_cast<int>(entries.size()) == TESTCASE_COUNT);
+    assert(entries.back().arg->getID() == std::to_string(TESTCASE_COUNT));
+    assert(entries.back().arg->getConfig().get("b").value() == std::to_string((TESTCASE_COUNT - 1) * 2));
+
+    Interface::NormalTemplate temp("manifest_large");
+    temp.define<AddGenerator, AddSolution>("add");
+    temp.load(manifest);
+}
+
+int main() {
+    testParse();
+    testInvalid();
+    testLoad();
+    testLargeManifest();
+    return 0;
+}
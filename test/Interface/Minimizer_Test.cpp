@@ -0,0 +1,100 @@
+#include <iostream>
+#include <string>
+#include <cassert>
+
+#include <MultiGenerator/Interface/Minimizer.hpp>
+
+namespace Variable = MultiGenerator::Variable;
+namespace Interface = MultiGenerator::Interface;
+
+class SumSolution : public Interface::SolutionTask {
+private:
+    void solve(std::istream &dataIn, std::ostream &dataOut, const Variable::DataConfig &) override {
+        long long sum = 0, x;
+
+        while (dataIn >> x)
+            sum += x;
+
+        dataOut << sum << std::endl;
+    }
+};
+
+/** A wrong solution which fails when some number is not less than 50. */
+class WrongSumSolution : public Interface::SolutionTask {
+private:
+    void solve(std::istream &dataIn, std::ostream &dataOut, const Variable::DataConfig &) override {
+        long long sum = 0, x;
+
+        while (dataIn >> x)
+            sum += (x >= 50 ? x + 1 : x);
+
+        dataOut << sum << std::endl;
+    }
+};
+
+void testSolveInMemory() {
+    auto res = Interface::solveInMemory<SumSolution>("1 2\n3\n");
+    assert(res == "6\n");
+}
+
+void testLineReducer() {
+    Interface::LineReducer reducer(1);
+    reducer.reset("h\na\nb\nc\n");
+    assert(reducer.next().value() == "h\nc\n");
+    assert(reducer.next().value() == "h\na\nb\n");
+    assert(reducer.next().value() == "h\nb\nc\n");
+    assert(reducer.next().value() == "h\na\nc\n");
+    assert(reducer.next().value() == "h\na\nb\n");
+    assert(!reducer.next().has_value());
+}
+
+void testEdgeReducer() {
+    Interface::EdgeReducer reducer;
+    reducer.reset("3 2\n1 2\n2 3\n1\n");
+    assert(reducer.next().value() == "3 1\n2 3\n1\n");
+    assert(reducer.next().value() == "3 1\n1 2\n1\n");
+    assert(!reducer.next().has_value());
+}
+
+void testNumberReducer() {
+    Interface::NumberReducer reducer;
+    reducer.reset("7 x 0");
+    assert(reducer.next().value() == "0 x 0");
+    assert(reducer.next().value() == "3 x 0");
+    assert(reducer.next().value() == "6 x 0");
+    assert(!reducer.next().has_value());
+}
+
+void testMinimizer() {
+    std::string input;
+
+    for (int i = 0; i < 40; ++i)
+        input += std::to_string(i == 23 ? 77 : i % 10) + " " + std::to_string(i % 7) + "\n";
+
+    Interface::Minimizer minimizer(Interface::mismatch<SumSolution, WrongSumSolution>(), 4);
+    minimizer.addReducer(std::make_unique<Interface::LineReducer>());
+    minimizer.addReducer(std::make_unique<Interface::NumberReducer>());
+
+    auto res = minimizer.minimize(input);
+    assert(res == "50 0\n");
+    assert(minimizer.getEvaluationCount() > 0);
+
+    bool thrown = false;
+
+    try {
+        minimizer.minimize("1 2\n");
+    } catch (const Interface::InputNotFailingException &) {
+        thrown = true;
+    }
+
+    assert(thrown);
+}
+
+int main() {
+    testSolveInMemory();
+    testLineReducer();
+    testEdgeReducer();
+    testNumberReducer();
+    testMinimizer();
+    return 0;
+}
@@ -0,0 +1,532 @@
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <stdexcept>
+#include <atomic>
+#include <optional>
+#include <cassert>
+
+#include <MultiGenerator/Interface/Template.hpp>
+
+namespace Variable = MultiGenerator::Variable;
+namespace Interface = MultiGenerator::Interface;
+
+class AddGenerator : public Interface::GeneratingTask {
+private:
+    void generate(std::ostream &data, const Variable::DataConfig &config) override {
+        int a = std::stoi(config.get("a").value());
+        int b = std::stoi(config.get("b").value());
+        data << a << " " << b << std::endl;
+    }
+};
+
+class AddSolution : public Interface::SolutionTask {
+private:
+    void solve(std::istream &dataIn, std::ostream &dataOut, const Variable::DataConfig &) override {
+        int a, b;
+        dataIn >> a >> b;
+        dataOut << a + b << std::endl;
+    }
+};
+
+/** A wrong solution which fails when a is odd. */
+class WrongAddSolution : public Interface::SolutionTask {
+private:
+    void solve(std::istream &dataIn, std::ostream &dataOut, const Variable::DataConfig &) override {
+        int a, b;
+        dataIn >> a >> b;
+        dataOut << (a % 2 == 0 ? a + b : a - b) << std::endl;
+    }
+};
+
+/** A solution which throws when a is 3. */
+class ThrowingAddSolution : public Interface::SolutionTask {
+private:
+    void solve(std::istream &dataIn, std::ostream &dataOut, const Variable::DataConfig &) override {
+        int a, b;
+        dataIn >> a >> b;
+
+        if (a == 3)
+            throw std::runtime_error("a is 3");
+
+        dataOut << a + b << std::endl;
+    }
+};
+
+/** A validator which requires a to be less than 5. */
+class AddValidator : public Interface::ValidatorTask {
+private:
+    bool validate(std::istream &dataIn, const Variable::DataConfig &) override {
+        int a, b;
+        return (dataIn >> a >> b) && a < 5;
+    }
+};
+
+/** A generator which writes much more than a pipe holds after a and b. */
+class PaddedAddGenerator : public Interface::GeneratingTask {
+public:
+    static constexpr int PADDING_COUNT = 1 << 18;
+private:
+    void generate(std::ostream &data, const Variable::DataConfig &config) override {
+        data << config.get("a").value() << " " << config.get("b").value() << "\n";
+
+        for (int i = 0; i < PADDING_COUNT; ++i)
+            data << i << "\n";
+    }
+};
+
+/** A validator which reads all the padding. */
+class PaddedAddValidator : public Interface::ValidatorTask {
+private:
+    bool validate(std::istream &dataIn, const Variable::DataConfig &) override {
+        int a, b, x, count = 0;
+
+        if (!(dataIn >> a >> b))
+            return false;
+
+        while (dataIn >> x && x == count)
+            ++count;
+
+        return count == PaddedAddGenerator::PADDING_COUNT;
+    }
+};
+
+struct AddParameters {
+    int a;
+    int b;
+
+    static Variable::Schema<AddParameters> getSchema() {
+        Variable::Schema<AddParameters> schema;
+        schema.required("a", &AddParameters::a).required("b", &AddParameters::b);
+        return schema;
+    }
+};
+
+class TypedAddGenerator : public Interface::TypedGeneratingTask<AddParameters> {
+private:
+    void generate(std::ostream &data, const AddParameters &parameters) override {
+        data << parameters.a << " " << parameters.b << std::endl;
+    }
+};
+
+class TypedAddSolution : public Interface::TypedSolutionTask<AddParameters> {
+private:
+    void solve(std::istream &dataIn, std::ostream &dataOut, const AddParameters &parameters) override {
+        int a, b;
+        dataIn >> a >> b;
+        assert(a == parameters.a && b == parameters.b);
+        dataOut << a + b << std::endl;
+    }
+};
+
+/** Read the answer of a test case, or nullopt if it can't be read. */
+std::optional<int> readAnswer(const std::string &name) {
+    std::ifstream ifs(name + ".out");
+    int res = 0;
+
+    if (!(ifs >> res))
+        return std::nullopt;
+
+    return res;
+}
+
+/** Remove the files of a test case, including the outputs of its candidates. */
+void removeTestcase(const std::string &name, int candidateCount = 0) {
+    namespace filesystem = std::filesystem;
+    filesystem::remove(filesystem::path(name + ".in"));
+    filesystem::remove(filesystem::path(name + ".out"));
+
+    for (int i = 0; i < candidateCount; ++i)
+        filesystem::remove(filesystem::path(name + Interface::CheckingTemplate::getOutputExtension(i)));
+}
+
+void testValidation() {
+    constexpr int TESTCASE_COUNT = 10;
+
+    Interface::NormalTemplate temp("validate");
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        temp.add<AddGenerator, AddSolution, AddValidator>(Interface::testcase(i, {
+            Interface::entry("a", i),
+            Interface::entry("b", i * 10)
+        }));
+    }
+
+    temp.execute(4);
+
+    auto records = temp.getValidationReport().getRecords();
+    assert(static_cast<int>(records.size()) == TESTCASE_COUNT);
+
+    for (const auto &record : records)
+        assert(record.valid == (std::stoi(record.testcase) < 5));
+
+    namespace filesystem = std::filesystem;
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        auto name = "validate" + std::to_string(i);
+        /** The solution of an invalid test case is skipped. */
+        assert(filesystem::exists(filesystem::path(name + ".in")));
+        assert(filesystem::exists(filesystem::path(name + ".out")) == (i < 5));
+        removeTestcase(name);
+    }
+}
+
+void testValidationOnOneWorker() {
+    constexpr int TESTCASE_COUNT = 2;
+
+    /** The validator starts after the generator, so it reads the input file. */
+    Interface::NormalTemplate temp("validate_padded");
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        temp.add<PaddedAddGenerator, AddSolution, PaddedAddValidator>(Interface::testcase(i, {
+            Interface::entry("a", i),
+            Interface::entry("b", i * 10)
+        }));
+    }
+
+    auto failures = temp.execute(1);
+    assert(failures.empty());
+
+    for (const auto &record : temp.getValidationReport().getRecords())
+        assert(record.valid);
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        auto name = "validate_padded" + std::to_string(i);
+        assert(readAnswer(name) == i * 11);
+        removeTestcase(name);
+    }
+}
+
+void testProcessSolution() {
+    constexpr int TESTCASE_COUNT = 10;
+
+    MultiGenerator::Context::ProcessConfig solution;
+    solution.path = "/bin/sh";
+    solution.arguments = { "-c", "read a b; echo $((a + b))" };
+
+    Interface::NormalTemplate temp("process");
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        temp.add<AddGenerator>(Interface::testcase(i, {
+            Interface::entry("a", i),
+            Interface::entry("b", i * 10)
+        }), solution);
+    }
+
+    temp.execute(4);
+
+    auto records = temp.getProcessReport().getRecords();
+    assert(static_cast<int>(records.size()) == TESTCASE_COUNT);
+
+    for (const auto &record : records)
+        assert(record.result.isSuccessful());
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        auto name = "process" + std::to_string(i);
+        auto res = readAnswer(name);
+        assert(res == i * 11);
+        removeTestcase(name);
+    }
+}
+
+void testCheckingTemplate() {
+    constexpr int TESTCASE_COUNT = 10;
+
+    Interface::CheckingTemplate temp("check");
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        temp.add<AddGenerator, AddSolution, Interface::TokenCheckerTask,
+            AddSolution, WrongAddSolution>(Interface::testcase(i, {
+            Interface::entry("a", i),
+            Interface::entry("b", i * 10)
+        }));
+    }
+
+    temp.execute(4);
+
+    auto records = temp.getReport().getRecords();
+    assert(static_cast<int>(records.size()) == TESTCASE_COUNT * 2);
+
+    for (const auto &record : records) {
+        int id = std::stoi(record.testcase);
+
+        if (record.candidate == 0)
+            assert(record.accepted);
+        else
+            assert(record.accepted == (id % 2 == 0));
+    }
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        auto name = "check" + std::to_string(i);
+        removeTestcase(name, 2);
+    }
+}
+
+/** The two numbers of an input, which count how many times they're parsed. */
+struct AddInput {
+    int a;
+    int b;
+
+    static inline std::atomic_int parseCount = 0;
+
+    static AddInput parse(std::istream &dataIn) {
+        AddInput res{};
+        dataIn >> res.a >> res.b;
+        ++parseCount;
+        return res;
+    }
+
+    static void serialize(std::ostream &data, const AddInput &input) {
+        data << input.a << " " << input.b << std::endl;
+    }
+};
+
+class ParsedAddSolution : public Interface::ParsedSolutionTask<AddInput> {
+private:
+    void solve(const AddInput &input, std::ostream &dataOut, const Variable::DataConfig &) override {
+        dataOut << input.a + input.b << std::endl;
+    }
+};
+
+void testParsedSolution() {
+    constexpr int TESTCASE_COUNT = 4;
+
+    Interface::CheckingTemplate temp("parsed");
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        temp.add<AddGenerator, ParsedAddSolution, Interface::TokenCheckerTask,
+            ParsedAddSolution, ParsedAddSolution>(Interface::testcase(i, {
+            Interface::entry("a", i),
+            Interface::entry("b", i * 10)
+        }));
+    }
+
+    auto failures = temp.execute(4);
+    assert(failures.empty());
+
+    /** The standard solution and both candidates share one parse. */
+    assert(AddInput::parseCount == TESTCASE_COUNT);
+
+    for (const auto &record : temp.getReport().getRecords())
+        assert(record.accepted);
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        auto name = "parsed" + std::to_string(i);
+        removeTestcase(name, 2);
+    }
+}
+
+class ObjectAddGenerator : public Interface::ObjectGeneratingTask<AddInput> {
+private:
+    AddInput generate(const Variable::DataConfig &config) override {
+        return { std::stoi(config.get("a").value()), std::stoi(config.get("b").value()) };
+    }
+};
+
+void testObjectGeneration() {
+    constexpr int TESTCASE_COUNT = 4;
+
+    Interface::NormalTemplate temp("object");
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        temp.add<ObjectAddGenerator, ParsedAddSolution>(Interface::testcase(i, {
+            Interface::entry("a", i),
+            Interface::entry("b", i * 10)
+        }));
+    }
+
+    int parseCount = AddInput::parseCount;
+    auto failures = temp.execute(4);
+    assert(failures.empty());
+    /** The solutions receive the objects without parsing. */
+    assert(AddInput::parseCount == parseCount);
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        auto name = "object" + std::to_string(i);
+        int a = 0, b = 0;
+        std::ifstream(name + ".in") >> a >> b;
+        auto res = readAnswer(name);
+        assert(a == i && b == i * 10 && res == i * 11);
+        removeTestcase(name);
+    }
+}
+
+void testMemoryBudget() {
+    constexpr int TESTCASE_COUNT = 10;
+
+    Interface::NormalTemplate temp("budget");
+    /** The memory grows with a, and the budget holds about two test cases. */
+    auto memory = [](const Variable::DataConfig &config) {
+        return std::stoul(config.get("a").value()) << 20;
+    };
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        temp.add<AddGenerator, AddSolution>(Interface::testcase(i, {
+            Interface::entry("a", i),
+            Interface::entry("b", i * 10)
+        }), memory);
+    }
+
+    temp.setMemoryBudget(16 << 20);
+    temp.setIOParallelCount(2);
+    temp.execute(4);
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        auto name = "budget" + std::to_string(i);
+        auto res = readAnswer(name);
+        assert(res == i * 11);
+        removeTestcase(name);
+    }
+}
+
+void testFailureSummary() {
+    constexpr int TESTCASE_COUNT = 5;
+
+    Interface::NormalTemplate temp("failure");
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        temp.add<AddGenerator, ThrowingAddSolution>(Interface::testcase(i, {
+            Interface::entry("a", i),
+            Interface::entry("b", 1)
+        }));
+    }
+
+    auto failures = temp.execute(2);
+    assert(failures.size() == 1);
+    assert(failures[0].testcase == "3");
+    assert(failures[0].reason == "a is 3");
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        auto name = "failure" + std::to_string(i);
+
+        if (i != 3) {
+            auto res = readAnswer(name);
+            assert(res == i + 1);
+        }
+
+        removeTestcase(name);
+    }
+}
+
+void testTypedParameters() {
+    constexpr int TESTCASE_COUNT = 5;
+
+    Interface::NormalTemplate temp("typed");
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        temp.add<TypedAddGenerator, TypedAddSolution>(Interface::testcase(i, {
+            Interface::entry("a", i),
+            Interface::entry("b", i * 10)
+        }));
+    }
+
+    /** A wrong config fails when the test case is added. */
+    try {
+        temp.add<TypedAddGenerator, TypedAddSolution>(Interface::testcase(TESTCASE_COUNT + 1, {
+            Interface::entry("a", 1)
+        }));
+        assert(false);
+    } catch (const Variable::SchemaException &) {}
+
+    auto failures = temp.execute(2);
+    assert(failures.empty());
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        auto name = "typed" + std::to_string(i);
+        auto res = readAnswer(name);
+        assert(res == i * 11);
+        removeTestcase(name);
+    }
+}
+
+/** A list counting how many test cases have been taken. */
+class CountingList : public Variable::SweepArgumentList {
+public:
+    using Variable::SweepArgumentList::SweepArgumentList;
+
+    std::optional<std::shared_ptr<Variable::Argument>> next() override {
+        auto res = Variable::SweepArgumentList::next();
+
+        if (res.has_value())
+            ++taken;
+
+        return res;
+    }
+
+    static inline std::atomic_int taken = 0;
+};
+
+/** Record how many test cases had been taken when the first one ran. */
+class CountingAddGenerator : public Interface::GeneratingTask {
+public:
+    static inline std::atomic_int takenAtFirst = -1;
+private:
+    void generate(std::ostream &data, const Variable::DataConfig &config) override {
+        int expected = -1;
+        takenAtFirst.compare_exchange_strong(expected, CountingList::taken.load());
+        data << config.get("a").value() << " " << config.get("b").value() << std::endl;
+    }
+};
+
+void testSweep() {
+    constexpr int TESTCASE_COUNT = 40;
+
+    Interface::NormalTemplate temp("sweep");
+    temp.setWindowSize(8);
+    temp.add<CountingAddGenerator, AddSolution>(std::make_shared<CountingList>(
+        std::make_shared<Variable::ProductSweep>(std::vector<std::shared_ptr<Variable::Sweep>>({
+            std::make_shared<Variable::RangeSweep>("a", 1, TESTCASE_COUNT / 2),
+            std::make_shared<Variable::ValueSweep>("b", std::vector<std::string>({ "100", "200" }))
+        }))));
+
+    assert(CountingList::taken == 0);
+    auto failures = temp.execute(2);
+    assert(failures.empty());
+    assert(CountingList::taken == TESTCASE_COUNT);
+    /** Only the first window and the one prepared during it can be taken. */
+    assert(CountingAddGenerator::takenAtFirst <= 16);
+    /** The test cases of lists aren't kept for the calibration. */
+    auto report = temp.calibrate();
+    assert(report.getResults().empty());
+
+    for (int i = 1; i <= TESTCASE_COUNT; ++i) {
+        auto name = "sweep" + std::to_string(i);
+        auto res = readAnswer(name);
+        assert(res == (i + 1) / 2 + (i % 2 == 1 ? 100 : 200));
+        removeTestcase(name);
+    }
+}
+
+void testSweepFailFast() {
+    Interface::NormalTemplate temp("sweep_fail");
+    temp.setFailurePolicy(MultiGenerator::Executor::FailurePolicy::FailFast);
+    temp.add<AddGenerator, ThrowingAddSolution>(Interface::testcase(1, {
+        Interface::entry("a", 3),
+        Interface::entry("b", 1)
+    }));
+    CountingList::taken = 0;
+    temp.add<AddGenerator, AddSolution>(std::make_shared<CountingList>(
+        std::make_shared<Variable::RangeSweep>("a", 1, 8), Variable::DataConfig({ { "b", "1" } }), 2));
+
+    /** The test cases of the list are never taken after the first one fails. */
+    auto failures = temp.execute(2);
+    assert(failures.size() == 1);
+    assert(CountingList::taken == 0);
+
+    removeTestcase("sweep_fail1");
+}
+
+int main() {
+    testValidation();
+    testValidationOnOneWorker();
+    testProcessSolution();
+    testCheckingTemplate();
+    testParsedSolution();
+    testObjectGeneration();
+    testMemoryBudget();
+    testFailureSummary();
+    testTypedParameters();
+    testSweep();
+    testSweepFailFast();
+    return 0;
+}
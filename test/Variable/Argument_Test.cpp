@@ -1,4 +1,7 @@
 #include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
 #include <cassert>
 
 #include <MultiGenerator/Variable/DataConfig.hpp>
@@ -156,6 +159,100 @@ void testArgumentList() {
     }
 }
 
+void testParseArgument() {
+    using Variable::DataConfig;
+
+    {
+        auto arg = Variable::parseArgument("3", DataConfig::create({ {"one", "1"} }));
+        assert(dynamic_cast<Variable::NormalArgument *>(arg.get()) != nullptr);
+        assert(arg->getID() == "3");
+        assert(arg->getConfig().get("one").value() == "1");
+    }
+
+    {
+        auto arg = Variable::parseArgument("2-5");
+        assert(dynamic_cast<Variable::SubtaskArgument *>(arg.get()) != nullptr);
+        assert(arg->getID() == "2-5");
+    }
+
+    for (auto id : { "", "a", "1-", "1-2-3", "1x" }) {
+        bool thrown = false;
+
+        try {
+            Variable::parseArgument(id);
+        } catch (const Variable::ArgumentIDInvalidException &) {
+            thrown = true;
+        }
+
+        assert(thrown);
+    }
+}
+
+/** Small parameters, which std::any would keep in its own buffer. */
+template <int Index>
+struct IndexParameters {
+    int value;
+
+    static Variable::Schema<IndexParameters> getSchema() {
+        Variable::Schema<IndexParameters> schema;
+        schema.optional("value", &IndexParameters::value, Index);
+        return schema;
+    }
+};
+
+void testParametersReference() {
+    Variable::NormalArgument arg(1);
+    const auto &first = arg.prepareParameters<IndexParameters<0>>();
+
+    /** Preparing more parameters doesn't move the ones prepared before. */
+    arg.prepareParameters<IndexParameters<1>>();
+    arg.prepareParameters<IndexParameters<2>>();
+    arg.prepareParameters<IndexParameters<3>>();
+    arg.prepareParameters<IndexParameters<4>>();
+
+    assert(&first == &arg.getParameters<IndexParameters<0>>());
+    assert(first.value == 0 && arg.getParameters<IndexParameters<4>>().value == 4);
+}
+
+void testSharedInput() {
+    Variable::NormalArgument arg(1);
+    std::atomic_int parseCount(0);
+    std::vector<std::shared_ptr<const std::vector<int>>> inputs(8);
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            inputs[i] = arg.getSharedInput<std::vector<int>>([&]() {
+                ++parseCount;
+                return std::vector<int>{ 1, 2, 3 };
+            });
+        });
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    /** Every task gets the same input, parsed once. */
+    assert(parseCount == 1);
+
+    for (const auto &input : inputs)
+        assert(input == inputs[0]);
+
+    /** Inputs of other types are kept apart. */
+    auto str = arg.getSharedInput<std::string>([]() { return std::string("input"); });
+    assert(*str == "input");
+
+    /** The holders keep the input after it's released, and it's parsed again later. */
+    arg.releaseSharedInputs();
+    assert((*inputs[0])[2] == 3);
+
+    auto again = arg.getSharedInput<std::vector<int>>([&]() {
+        ++parseCount;
+        return std::vector<int>{ 4 };
+    });
+    assert(parseCount == 2 && again->front() == 4);
+}
+
 int main() {
     testNormalArgument();
     testSubtaskArgument();
@@ -163,6 +260,9 @@ int main() {
     testNormalArgumentList();
     testSubtaskArgumentList();
     testArgumentList();
+    testParseArgument();
+    testParametersReference();
+    testSharedInput();
     return 0;
 }
 
@@ -36,6 +36,36 @@ int main() {
         assert(config.get("two").value() == "2");
         assert(config.get("three").value() == "3");
     }
+
+    {
+        Variable::DataConfig config({ {"n", "1"}, {"m", "2"}, {"n", "3"} });
+        assert(config.size() == 2);
+        assert(config.get("n").value() == "1");
+
+        std::string keys;
+        config.forEach([&keys](const std::string &key, const std::string &) {
+            keys += key;
+        });
+        assert(keys == "mn");
+    }
+
+    {
+        Variable::DataConfig base({ {"n", "100"}, {"m", "200"} });
+        Variable::DataConfig first = base, second = base;
+        assert(first.isSharedWith(base) && second.isSharedWith(base));
+
+        /** Changing a value to itself keeps the pairs shared. */
+        first.change("n", "100");
+        assert(first.isSharedWith(base));
+
+        first.change("n", "5");
+        assert(!first.isSharedWith(base) && second.isSharedWith(base));
+        assert(first.get("n").value() == "5");
+        assert(base.get("n").value() == "100" && second.get("n").value() == "100");
+
+        second.erase("m");
+        assert(!second.contain("m") && base.contain("m"));
+    }
     
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include <iostream>
+#include <string>
+#include <cassert>
+
+#include <MultiGenerator/Variable/DataConfig.hpp>
+#include <MultiGenerator/Variable/Schema.hpp>
+#include <MultiGenerator/Variable/Argument.hpp>
+
+namespace Variable = MultiGenerator::Variable;
+
+struct Parameters {
+    int n;
+    long long m;
+    double p;
+    bool isTree;
+    std::string name;
+
+    static Variable::Schema<Parameters> getSchema() {
+        Variable::Schema<Parameters> schema;
+        schema.required("n", &Parameters::n)
+            .optional("m", &Parameters::m, 10LL)
+            .optional("p", &Parameters::p, 0.5)
+            .optional("tree", &Parameters::isTree, false)
+            .optional("name", &Parameters::name, std::string("random"));
+        return schema;
+    }
+};
+
+bool isInvalid(const Variable::DataConfig &config, const std::string &message) {
+    try {
+        Variable::parseParameters<Parameters>(config);
+    } catch (const Variable::SchemaException &e) {
+        return std::string(e.what()).find(message) != std::string::npos;
+    }
+
+    return false;
+}
+
+void testSchema() {
+    auto parameters = Variable::parseParameters<Parameters>(Variable::DataConfig::create({
+        { "n", "5" }, { "p", "0.25" }, { "tree", "true" }
+    }));
+    assert(parameters.n == 5 && parameters.m == 10);
+    assert(parameters.p == 0.25 && parameters.isTree && parameters.name == "random");
+
+    parameters = Variable::parseParameters<Parameters>(Variable::DataConfig::create({
+        { "n", "-3" }, { "m", "10000000000" }, { "name", "chain" }
+    }));
+    assert(parameters.n == -3 && parameters.m == 10000000000LL && parameters.name == "chain");
+
+    assert(isInvalid(Variable::DataConfig::create({ { "m", "1" } }), "\"n\" is missing"));
+    assert(isInvalid(Variable::DataConfig::create({ { "n", "5x" } }), "\"n\" has an invalid value \"5x\""));
+    assert(isInvalid(Variable::DataConfig::create({ { "n", "99999999999" } }), "\"n\""));
+    assert(isInvalid(Variable::DataConfig::create({ { "n", "1" }, { "p", "" } }), "\"p\""));
+    assert(isInvalid(Variable::DataConfig::create({ { "n", "1" }, { "tree", "yes" } }), "\"tree\""));
+}
+
+void testArgumentParameters() {
+    Variable::NormalArgument arg(1, Variable::DataConfig::create({ { "n", "7" } }));
+
+    try {
+        arg.getParameters<Parameters>();
+        assert(false);
+    } catch (const Variable::ParametersNotPreparedException &) {}
+
+    const auto &prepared = arg.prepareParameters<Parameters>();
+    assert(prepared.n == 7);
+    assert(&arg.prepareParameters<Parameters>() == &arg.getParameters<Parameters>());
+    assert(arg.getParameters<Parameters>().m == 10);
+}
+
+int main() {
+    testSchema();
+    testArgumentParameters();
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <set>
+#include <cassert>
+
+#include <MultiGenerator/Variable/DataConfig.hpp>
+#include <MultiGenerator/Variable/Sweep.hpp>
+
+namespace Variable = MultiGenerator::Variable;
+
+std::vector<std::string> collect(const Variable::Sweep &sweep) {
+    std::vector<std::string> res;
+
+    for (std::size_t i = 0; i < sweep.size(); ++i) {
+        Variable::Sweep::Point point;
+        sweep.get(i, point);
+        std::string str;
+
+        for (const auto &[key, value] : point)
+            str += key + "=" + value + ";";
+
+        res.push_back(str);
+    }
+
+    return res;
+}
+
+void testRangeSweep() {
+    assert(collect(Variable::RangeSweep("n", 1, 7, 3)) == std::vector<std::string>({ "n=1;", "n=4;", "n=7;" }));
+    assert(collect(Variable::RangeSweep("n", 5, 1, -2)) == std::vector<std::string>({ "n=5;", "n=3;", "n=1;" }));
+    assert(Variable::RangeSweep("n", 5, 1).size() == 0);
+
+    try {
+        Variable::RangeSweep("n", 1, 5, 0);
+        assert(false);
+    } catch (const Variable::SweepInvalidException &) {}
+}
+
+void testGeometricSweep() {
+    assert(collect(Variable::GeometricSweep("n", 1, 1000, 10))
+        == std::vector<std::string>({ "n=1;", "n=10;", "n=100;", "n=1000;" }));
+    /** 1, 1.5, 2.25, 3.375 and 5.0625 are rounded, and the duplicate 2 is skipped. */
+    assert(collect(Variable::GeometricSweep("n", 1, 5, 1.5))
+        == std::vector<std::string>({ "n=1;", "n=2;", "n=3;", "n=5;" }));
+}
+
+void testProductSweep() {
+    Variable::ProductSweep sweep({
+        std::make_shared<Variable::RangeSweep>("n", 1, 2),
+        std::make_shared<Variable::ValueSweep>("type", std::vector<std::string>({ "tree", "chain", "star" }))
+    });
+    auto points = collect(sweep);
+    assert(points.size() == 6);
+    assert(points[0] == "n=1;type=tree;");
+    assert(points[2] == "n=1;type=star;");
+    assert(points[5] == "n=2;type=star;");
+}
+
+void testSampleSweep() {
+    auto base = std::make_shared<Variable::RangeSweep>("n", 1, 1000000);
+    Variable::SampleSweep first(base, 100, 42), second(base, 100, 42), third(base, 100, 43);
+    auto points = collect(first);
+    assert(points.size() == 100);
+    assert(points == collect(second));
+    assert(points != collect(third));
+    assert(std::set<std::string>(points.begin(), points.end()).size() > 90);
+}
+
+void testSweepArgumentList() {
+    Variable::DataConfig base({ { "m", "5" }, { "n", "0" } });
+    Variable::SweepArgumentList list(2, std::make_shared<Variable::RangeSweep>("n", 10, 12), base, 4);
+    assert(list.size() == 3);
+
+    for (int i = 0; i < 3; ++i) {
+        auto arg = list.next();
+        assert(arg.has_value());
+        assert(arg.value()->getID() == "2-" + std::to_string(4 + i));
+        assert(arg.value()->getConfig().get("n").value() == std::to_string(10 + i));
+        assert(arg.value()->getConfig().get("m").value() == "5");
+    }
+
+    assert(list.size() == 0 && !list.next().has_value());
+    assert(base.get("n").value() == "0");
+}
+
+int main() {
+    testRangeSweep();
+    testGeometricSweep();
+    testProductSweep();
+    testSampleSweep();
+    testSweepArgumentList();
+    return 0;
+}
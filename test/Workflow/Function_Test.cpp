@@ -0,0 +1,58 @@
+#include <iostream>
+#include <memory>
+#include <array>
+#include <cassert>
+
+#include <MultiGenerator/Workflow/Function.hpp>
+
+namespace Workflow = MultiGenerator::Workflow;
+
+void testSmallFunction() {
+    Workflow::SmallFunction<int(int)> empty;
+    assert(!empty);
+
+    /** A move-only object stored inline. */
+    auto value = std::make_unique<int>(10);
+    Workflow::SmallFunction<int(int)> add([value = std::move(value)](int x) {
+        return *value + x;
+    });
+    assert(add && add(5) == 15);
+
+    auto moved = std::move(add);
+    assert(!add && moved(1) == 11);
+
+    /** A large object stored on the heap. */
+    std::array<int, 64> numbers{};
+    numbers[63] = 7;
+    Workflow::SmallFunction<int(int)> large([numbers](int x) {
+        return numbers[63] * x;
+    });
+    assert(large(3) == 21);
+
+    moved = std::move(large);
+    assert(!large && moved(2) == 14);
+}
+
+void testSmallFunctionDestroy() {
+    auto counter = std::make_shared<int>(0);
+
+    {
+        Workflow::SmallFunction<void()> function([counter]() {
+            ++*counter;
+        });
+        function();
+        assert(counter.use_count() == 2);
+
+        Workflow::SmallFunction<void()> other(std::move(function));
+        other();
+        assert(counter.use_count() == 2);
+    }
+
+    assert(*counter == 2 && counter.use_count() == 1);
+}
+
+int main() {
+    testSmallFunction();
+    testSmallFunctionDestroy();
+    return 0;
+}
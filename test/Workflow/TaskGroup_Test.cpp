@@ -1,6 +1,10 @@
 #include <iostream>
 #include <string>
 #include <memory>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <tuple>
 #include <cassert>
 
 #include <MultiGenerator/Variable/Argument.hpp>
@@ -47,7 +51,135 @@ void testTaskGroup() {
     assert(p->getResult() == "TestTask: successful test");
 }
 
+void testTaskGroupStage() {
+    Workflow::TaskGroup group(std::make_shared<Variable::NormalArgument>(
+        1,
+        Variable::DataConfig::create({
+            {"result", "successful test"}
+        })
+    ));
+
+    auto constructor = []() -> std::unique_ptr<Workflow::Task> {
+        return std::make_unique<TestTask>();
+    };
+
+    int first = group.add(constructor);
+    auto ids = group.addParallel({ constructor, constructor, constructor });
+    int last = group.add(constructor);
+
+    auto stage = group.nextStage();
+    assert(stage.size() == 1 && stage[0].id == first);
+
+    stage = group.nextStage();
+    assert(stage.size() == 3);
+
+    for (int i = 0; i < 3; ++i)
+        assert(stage[i].id == ids[i]);
+
+    stage = group.nextStage();
+    assert(stage.size() == 1 && stage[0].id == last);
+    assert(group.nextStage().empty());
+}
+
+void testMixedStage() {
+    Workflow::TaskGroup group(std::make_shared<Variable::NormalArgument>(1));
+    auto constructor = []() -> std::unique_ptr<Workflow::Task> {
+        return std::make_unique<TestTask>();
+    };
+
+    auto ids = group.addParallel({
+        { constructor, Workflow::ResourceClass::IO },
+        { constructor, Workflow::ResourceClass::CPU }
+    });
+
+    assert(ids.size() == 2 && group.getStageCount() == 1);
+    assert(group.getEntry(ids[0]).resourceClass == Workflow::ResourceClass::IO);
+    assert(group.getEntry(ids[1]).resourceClass == Workflow::ResourceClass::CPU);
+    assert(group.nextStage().size() == 2);
+}
+
+void testSharedLayout() {
+    auto layout = std::make_shared<Workflow::TaskLayout>();
+    layout->add([]() {
+        return std::make_unique<TestTask>();
+    });
+    layout->setType("shared");
+
+    Workflow::TaskGroup first(std::make_shared<Variable::NormalArgument>(
+        1, Variable::DataConfig::create({ {"result", "first"} })), layout);
+    Workflow::TaskGroup second(std::make_shared<Variable::NormalArgument>(
+        2, Variable::DataConfig::create({ {"result", "second"} })), layout);
+
+    /** The same type doesn't copy the layout. */
+    first.setType("shared");
+    assert(first.getLayout() == layout && second.getLayout() == layout);
+
+    auto [begin, end] = first.nextStageRange();
+    assert(begin == 0 && end == 1);
+
+    auto task = first.createTask(begin);
+    task->call();
+    assert(dynamic_cast<TestTask *>(task.get())->getResult() == "TestTask: first");
+
+    task = second.createTask(0);
+    task->call();
+    assert(dynamic_cast<TestTask *>(task.get())->getResult() == "TestTask: second");
+
+    /** Changing a group copies the layout, so the others are kept. */
+    second.add([]() {
+        return std::make_unique<TestTask>();
+    });
+    assert(second.getLayout() != layout && second.getStageCount() == 2);
+    assert(layout->getTaskCount() == 1 && first.getStageCount() == 1);
+}
+
+void testConcurrentTaskGroup() {
+    constexpr int TASK_COUNT = 1000;
+    constexpr int THREAD_COUNT = 4;
+
+    Workflow::TaskGroup group(std::make_shared<Variable::NormalArgument>(1));
+    auto constructor = []() -> std::unique_ptr<Workflow::Task> {
+        return std::make_unique<TestTask>();
+    };
+
+    for (int i = 0; i < TASK_COUNT / 2; ++i)
+        group.add(constructor);
+
+    for (int i = 0; i < TASK_COUNT / 4; ++i)
+        group.addParallel({ constructor, constructor });
+
+    /** Every task is taken by exactly one thread. */
+    std::vector<std::atomic_int> taken(TASK_COUNT);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < THREAD_COUNT; ++i) {
+        threads.emplace_back([&, i]() {
+            if (i % 2 == 0) {
+                while (auto entry = group.next())
+                    ++taken[entry.value().id];
+            } else {
+                for (auto [first, last] = group.nextStageRange(); first != last; std::tie(first, last) = group.nextStageRange()) {
+                    for (int id = first; id < last; ++id)
+                        ++taken[id];
+                }
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    for (const auto &count : taken)
+        assert(count == 1);
+
+    assert(!group.next().has_value());
+}
+
 int main() {
     testTaskGroup();
+    testTaskGroupStage();
+    testMixedStage();
+    testSharedLayout();
+    testConcurrentTaskGroup();
     return 0;
 }
\ No newline at end of file